@@ -2,4 +2,5 @@ pub mod always_success;
 pub mod overall;
 pub mod resolve;
 pub mod secp_2in2out;
+pub mod tx_pool;
 pub mod util;
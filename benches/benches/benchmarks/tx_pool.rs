@@ -0,0 +1,136 @@
+use crate::benchmarks::overall::{gen_txs_from_block, setup_chain};
+use crate::benchmarks::util::{create_2out_transaction, create_secp_tx, secp_cell};
+use ckb_types::{
+    core::TransactionView,
+    packed::{CellDep, OutPoint},
+    prelude::*,
+};
+use criterion::{criterion_group, BatchSize, BenchmarkId, Criterion};
+use std::thread;
+
+#[cfg(not(feature = "ci"))]
+const SIZE: usize = 500;
+
+#[cfg(feature = "ci")]
+const SIZE: usize = 5;
+
+const SUBMITTERS: usize = 4;
+const CONFLICT_PERCENTS: &[usize] = &[0, 20];
+
+/// Builds a conflicting double-spend for the given transaction: same inputs
+/// in reversed order, which re-signs into a distinct transaction spending
+/// the same out points.
+fn conflicting_tx(tx: &TransactionView) -> TransactionView {
+    let tx_deps = create_secp_tx();
+    let secp_cell_deps = vec![
+        CellDep::new_builder()
+            .out_point(OutPoint::new(tx_deps.hash(), 0))
+            .build(),
+        CellDep::new_builder()
+            .out_point(OutPoint::new(tx_deps.hash(), 1))
+            .build(),
+    ];
+    let (_, _, secp_script) = secp_cell();
+    let mut inputs: Vec<OutPoint> = tx
+        .input_pts_iter()
+        .collect();
+    inputs.reverse();
+    create_2out_transaction(inputs, secp_script.clone(), secp_cell_deps)
+}
+
+fn bench(c: &mut Criterion) {
+    let mut group = c.benchmark_group("tx_pool");
+    group.sample_size(10);
+
+    // Concurrent submission flood: SUBMITTERS threads drive submit_local_tx
+    // against the service, with a percentage of conflicting double-spends
+    // mixed in to exercise the rejection path.
+    for conflict_percent in CONFLICT_PERCENTS.iter() {
+        group.bench_with_input(
+            BenchmarkId::new(
+                format!("flood_{}_submitters", SUBMITTERS),
+                format!("{}%_conflicts", conflict_percent),
+            ),
+            conflict_percent,
+            |b, conflict_percent| {
+                b.iter_batched(
+                    || {
+                        let (shared, chain) = setup_chain(SIZE);
+                        let genesis = shared.consensus().genesis_block().clone();
+                        let txs = gen_txs_from_block(&genesis);
+                        let conflicts: Vec<TransactionView> = txs
+                            .iter()
+                            .take(txs.len() * conflict_percent / 100)
+                            .map(conflicting_tx)
+                            .collect();
+                        (shared, chain, txs, conflicts)
+                    },
+                    |(shared, _chain, txs, conflicts)| {
+                        let chunk = (txs.len() + SUBMITTERS - 1) / SUBMITTERS;
+                        let handles: Vec<_> = txs
+                            .chunks(chunk)
+                            .map(|batch| {
+                                let controller = shared.tx_pool_controller().clone();
+                                let batch = batch.to_vec();
+                                thread::spawn(move || {
+                                    for tx in batch {
+                                        let _ = controller.submit_local_tx(tx);
+                                    }
+                                })
+                            })
+                            .collect();
+                        for handle in handles {
+                            handle.join().unwrap();
+                        }
+                        // conflicts arrive after the originals, every one of
+                        // them must travel the full reject path
+                        let controller = shared.tx_pool_controller();
+                        for tx in conflicts {
+                            let _ = controller.submit_local_tx(tx);
+                        }
+                    },
+                    BatchSize::PerIteration,
+                )
+            },
+        );
+    }
+
+    // Template latency against a populated pool, the number block producers
+    // stare at when the pool grows.
+    group.bench_with_input(
+        BenchmarkId::new("get_block_template", SIZE),
+        &SIZE,
+        |b, _| {
+            b.iter_batched(
+                || {
+                    let (shared, chain) = setup_chain(SIZE);
+                    let genesis = shared.consensus().genesis_block().clone();
+                    let controller = shared.tx_pool_controller();
+                    for tx in gen_txs_from_block(&genesis) {
+                        controller
+                            .submit_local_tx(tx)
+                            .expect("submit")
+                            .expect("verify");
+                    }
+                    (shared, chain)
+                },
+                |(shared, _chain)| {
+                    shared
+                        .tx_pool_controller()
+                        .get_block_template(None, None, None)
+                        .expect("template request")
+                        .expect("template");
+                },
+                BatchSize::PerIteration,
+            )
+        },
+    );
+
+    group.finish();
+}
+
+criterion_group!(
+    name = tx_pool;
+    config = Criterion::default().sample_size(10);
+    targets = bench
+);
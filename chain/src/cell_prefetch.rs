@@ -0,0 +1,62 @@
+//! Parallel materialization of the store cells referenced by a block.
+//!
+//! Cell resolution walks a block transaction-by-transaction, each issuing
+//! serial `CellProvider` lookups against the store. The out points a block
+//! reads from the store are known up front though: every input and cell dep
+//! that is not created by the block itself. This module gathers them,
+//! deduplicates them, and materializes their `CellMeta`s with grouped store
+//! reads across the rayon thread pool; the resulting map is layered over the
+//! authoritative provider via `PrefetchedCellProvider`, so the subsequent
+//! serial resolution pass keeps all of its validation logic but finds the
+//! store reads already done.
+//!
+//! Only live cells enter the map and only non-eager lookups are served from
+//! it, so resolution behaves exactly as if every lookup had gone to the
+//! underlying provider — the prefetch can only be engaged when that provider
+//! sees the same state as the one prefetched from (see the call sites in
+//! `chain.rs` and `resolve_pipeline.rs`).
+
+use ckb_types::{
+    core::{
+        cell::{gather_block_referenced_out_points, CellMeta, CellProvider, CellStatus},
+        BlockView,
+    },
+    packed::OutPoint,
+};
+use rayon::prelude::*;
+use std::collections::HashMap;
+
+/// Out points per grouped store read; keeps per-task overhead low while
+/// leaving enough groups to spread over the pool.
+const PREFETCH_CHUNK_SIZE: usize = 16;
+
+/// Blocks referencing fewer distinct out points than this are left to the
+/// serial resolution pass, the thread pool handoff costs more than it saves.
+const PREFETCH_THRESHOLD: usize = 32;
+
+/// Materializes the `CellMeta`s of all out points the block reads from
+/// `provider`, in parallel. Returns an empty map (prefetch disengaged) for
+/// blocks too small to be worth the fan-out.
+pub(crate) fn prefetch_block_cells<CP: CellProvider + Sync>(
+    provider: &CP,
+    block: &BlockView,
+) -> HashMap<OutPoint, CellMeta> {
+    let out_points = gather_block_referenced_out_points(block);
+    if out_points.len() < PREFETCH_THRESHOLD {
+        return HashMap::new();
+    }
+
+    out_points
+        .par_chunks(PREFETCH_CHUNK_SIZE)
+        .flat_map_iter(|chunk| {
+            chunk.iter().filter_map(|out_point| {
+                // dead or unknown out points are left to the authoritative
+                // provider, resolution reports them with its usual errors
+                match provider.cell(out_point, false) {
+                    CellStatus::Live(cell_meta) => Some((out_point.clone(), cell_meta)),
+                    _ => None,
+                }
+            })
+        })
+        .collect()
+}
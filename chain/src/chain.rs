@@ -1,6 +1,8 @@
 //! CKB chain service.
 #![allow(missing_docs)]
 
+use crate::cell_prefetch::prefetch_block_cells;
+use crate::resolve_pipeline::ResolvePipeline;
 use ckb_channel::{self as channel, select, Sender};
 use ckb_error::{Error, InternalErrorKind};
 use ckb_logger::{self, debug, error, info, log_enabled, trace, warn};
@@ -15,7 +17,7 @@ use ckb_types::{
     core::{
         cell::{
             resolve_transaction_with_options, BlockCellProvider, OverlayCellProvider,
-            ResolveOptions, ResolvedTransaction,
+            PrefetchedCellProvider, ResolveOptions, ResolvedTransaction,
         },
         service::{Request, DEFAULT_CHANNEL_SIZE, SIGNAL_CHANNEL_SIZE},
         BlockExt, BlockNumber, BlockView, HeaderView,
@@ -354,7 +356,9 @@ impl ChainService {
         }
         // non-contextual verify
         if !switch.disable_non_contextual() {
+            let timer = Timer::start();
             self.non_contextual_verify(&block)?;
+            metrics!(timing, "ckb.block_stage.non_contextual_verify", timer.stop());
         }
 
         let mut total_difficulty = U256::zero();
@@ -429,7 +433,9 @@ impl ChainService {
 
             // update and verify chain root
             // MUST update index before reconcile_main_chain
+            let timer = Timer::start();
             self.reconcile_main_chain(&db_txn, &mut fork, switch)?;
+            metrics!(timing, "ckb.block_stage.reconcile", timer.stop());
 
             db_txn.insert_tip_header(&block.header())?;
             if new_epoch || fork.has_detached() {
@@ -439,7 +445,9 @@ impl ChainService {
         } else {
             db_txn.insert_block_ext(&block.header().hash(), &ext)?;
         }
+        let timer = Timer::start();
         db_txn.commit()?;
+        metrics!(timing, "ckb.block_stage.commit", timer.stop());
 
         if new_best_block {
             let tip_header = block.header();
@@ -707,7 +715,31 @@ impl ChainService {
         let verify_context = VerifyContext::new(txn, self.shared.consensus());
         let async_handle = self.shared.tx_pool_controller().handle();
 
+        // Overlap cell resolution of later unverified blocks with script
+        // verification of earlier ones. The resolver works against the shared
+        // snapshot plus the outputs of preceding fork blocks, which matches
+        // the store transaction's view only when nothing has been detached
+        // and no previously verified prefix was attached, so the pipeline is
+        // engaged for the plain multi-block attachment case and any
+        // speculative failure falls back to in-line resolution.
+        let mut resolve_pipeline = if !switch.disable_all()
+            && verified_len == 0
+            && !fork.has_detached()
+            && fork.attached_blocks().len() > 1
+        {
+            let blocks: Vec<BlockView> = fork.attached_blocks().iter().cloned().collect();
+            debug!("resolve pipeline engaged for {} blocks", blocks.len());
+            ResolvePipeline::spawn(Arc::clone(&self.shared.snapshot()), blocks)
+        } else {
+            None
+        };
+
         let mut found_error = None;
+        // The store transaction sees exactly the shared snapshot until the
+        // first block of the fork is attached to it, which is when the cell
+        // prefetch map (built against the snapshot) may safely shortcut the
+        // authoritative provider.
+        let mut txn_matches_snapshot = verified_len == 0 && !fork.has_detached();
         for (ext, b) in fork
             .dirty_exts
             .iter()
@@ -734,26 +766,56 @@ impl ChainService {
                         ResolveOptions::empty().set_skip_immature_header_deps_check(flag)
                     };
 
-                    let resolved = {
-                        let txn_cell_provider = txn.cell_provider();
-                        let cell_provider = OverlayCellProvider::new(&block_cp, &txn_cell_provider);
-                        transactions
-                            .iter()
-                            .cloned()
-                            .map(|x| {
-                                resolve_transaction_with_options(
-                                    x,
-                                    &mut seen_inputs,
-                                    &cell_provider,
-                                    &verify_context,
-                                    resolve_opts,
-                                )
-                            })
-                            .collect::<Result<Vec<ResolvedTransaction>, _>>()
+                    let speculative = match resolve_pipeline.as_ref() {
+                        Some(pipeline) => {
+                            let ret = pipeline.recv(&b.hash());
+                            if ret.is_none() {
+                                resolve_pipeline = None;
+                            }
+                            ret.and_then(Result::ok)
+                        }
+                        None => None,
+                    };
+
+                    let resolve_timer = Timer::start();
+                    let resolved = match speculative {
+                        Some(resolved) => Ok(resolved),
+                        None => {
+                            // authoritative in-line resolution against the
+                            // store transaction, with the independent store
+                            // reads fanned out in advance when the prefetch
+                            // snapshot is known to match its view
+                            let prefetched = if txn_matches_snapshot {
+                                prefetch_block_cells(self.shared.snapshot().as_ref(), b)
+                            } else {
+                                Default::default()
+                            };
+                            let txn_cell_provider = txn.cell_provider();
+                            let prefetched_provider =
+                                PrefetchedCellProvider::new(prefetched, &txn_cell_provider);
+                            let cell_provider =
+                                OverlayCellProvider::new(&block_cp, &prefetched_provider);
+                            transactions
+                                .iter()
+                                .cloned()
+                                .map(|x| {
+                                    resolve_transaction_with_options(
+                                        x,
+                                        &mut seen_inputs,
+                                        &cell_provider,
+                                        &verify_context,
+                                        resolve_opts,
+                                    )
+                                })
+                                .collect::<Result<Vec<ResolvedTransaction>, _>>()
+                                .map_err(Into::into)
+                        }
                     };
 
                     match resolved {
                         Ok(resolved) => {
+                            metrics!(timing, "ckb.block_stage.resolve", resolve_timer.stop());
+                            let verify_timer = Timer::start();
                             match contextual_block_verifier.verify(
                                 &resolved,
                                 b,
@@ -762,6 +824,11 @@ impl ChainService {
                                 switch,
                             ) {
                                 Ok((cycles, cache_entries)) => {
+                                    metrics!(
+                                        timing,
+                                        "ckb.block_stage.verify",
+                                        verify_timer.stop()
+                                    );
                                     let txs_fees =
                                         cache_entries.into_iter().map(|entry| entry.fee).collect();
                                     txn.attach_block(b)?;
@@ -796,7 +863,7 @@ impl ChainService {
                             }
                         }
                         Err(err) => {
-                            found_error = Some(err.into());
+                            found_error = Some(err);
                             let mut mut_ext = ext.clone();
                             mut_ext.verified = Some(false);
                             txn.insert_block_ext(&b.header().hash(), &mut_ext)?;
@@ -814,6 +881,7 @@ impl ChainService {
                 mut_ext.verified = Some(true);
                 txn.insert_block_ext(&b.header().hash(), &mut_ext)?;
             }
+            txn_matches_snapshot = false;
         }
 
         if let Some(err) = found_error {
@@ -7,5 +7,7 @@
 //! [`ChainController`]: chain/struct.ChainController.html
 
 pub mod chain;
+mod cell_prefetch;
+mod resolve_pipeline;
 #[cfg(test)]
 mod tests;
@@ -0,0 +1,159 @@
+//! Speculative cell resolution pipeline used while attaching multi-block forks.
+//!
+//! When `reconcile_main_chain` attaches several unverified blocks in one go
+//! (e.g. replaying stored-but-unverified blocks after a restart, or switching
+//! to a longer fork), cell resolution of block N+1 is independent from script
+//! verification of block N as long as resolution can see the outputs created
+//! and consumed by the preceding fork blocks. This module runs resolution one
+//! step ahead on a dedicated thread, against the shared snapshot with the
+//! preceding fork blocks overlaid, feeding the chain thread through a bounded
+//! channel.
+//!
+//! The snapshot based view matches the store transaction's view only in the
+//! plain attachment case (nothing detached, no previously verified fork
+//! prefix), and only successful speculative resolutions are used: any
+//! speculative failure is re-resolved in-line against the store transaction,
+//! so the authoritative result never depends on the speculation.
+
+use crate::cell_prefetch::prefetch_block_cells;
+use ckb_channel::{self as channel, Receiver};
+use ckb_error::Error;
+use ckb_shared::Snapshot;
+use ckb_types::{
+    core::{
+        cell::{
+            resolve_transaction_with_options, BlockCellProvider, CellProvider, CellStatus,
+            OverlayCellProvider, PrefetchedCellProvider, ResolveOptions, ResolvedTransaction,
+        },
+        BlockView,
+    },
+    packed::{Byte32, OutPoint},
+};
+use std::collections::HashSet;
+use std::sync::Arc;
+use std::thread;
+
+/// Number of blocks the resolver may run ahead of the verifier.
+const PIPELINE_DEPTH: usize = 2;
+
+/// Resolves cells against the store-backed provider (the shared snapshot,
+/// possibly behind a prefetch map) with the outputs of preceding (attached
+/// but not yet committed) fork blocks overlaid on top.
+struct ForkCellProvider<'a, CP> {
+    store: &'a CP,
+    ancestors: &'a [BlockCellProvider<'a>],
+}
+
+impl<'a, CP: CellProvider> CellProvider for ForkCellProvider<'a, CP> {
+    fn cell(&self, out_point: &OutPoint, eager_load: bool) -> CellStatus {
+        for ancestor in self.ancestors.iter().rev() {
+            match ancestor.cell(out_point, eager_load) {
+                CellStatus::Unknown => continue,
+                status => return status,
+            }
+        }
+        self.store.cell(out_point, eager_load)
+    }
+}
+
+fn resolve_block(
+    snapshot: &Snapshot,
+    ancestors: &[BlockCellProvider],
+    block_cp: &BlockCellProvider,
+    seen_inputs: &mut HashSet<OutPoint>,
+    block: &BlockView,
+) -> Result<Vec<ResolvedTransaction>, Error> {
+    let resolve_opts = {
+        let hardfork_switch = snapshot.consensus().hardfork_switch();
+        let flag =
+            hardfork_switch.is_remove_header_deps_immature_rule_enabled(block.epoch().number());
+        ResolveOptions::empty().set_skip_immature_header_deps_check(flag)
+    };
+
+    // snapshot reads the block will issue are independent, fan them out
+    // before the serial resolution pass; cells spent by ancestor fork blocks
+    // are still caught through the carried `seen_inputs`
+    let prefetched = prefetch_block_cells(snapshot, block);
+    let store_provider = PrefetchedCellProvider::new(prefetched, snapshot);
+    let fork_provider = ForkCellProvider {
+        store: &store_provider,
+        ancestors,
+    };
+    let cell_provider = OverlayCellProvider::new(block_cp, &fork_provider);
+
+    block
+        .transactions()
+        .iter()
+        .cloned()
+        .map(|tx| {
+            resolve_transaction_with_options(
+                tx,
+                seen_inputs,
+                &cell_provider,
+                snapshot,
+                resolve_opts,
+            )
+        })
+        .collect::<Result<Vec<ResolvedTransaction>, _>>()
+        .map_err(Into::into)
+}
+
+/// Handle held by the chain thread; dropping it stops the resolver early.
+pub(crate) struct ResolvePipeline {
+    receiver: Receiver<(Byte32, Result<Vec<ResolvedTransaction>, Error>)>,
+}
+
+impl ResolvePipeline {
+    /// Spawns the resolver thread over the given snapshot and the fork's
+    /// attached blocks, in chain order. Returns `None` if the thread can not
+    /// be spawned, in which case the caller resolves in-line as before.
+    pub(crate) fn spawn(
+        snapshot: Arc<Snapshot>,
+        blocks: Vec<BlockView>,
+    ) -> Option<ResolvePipeline> {
+        let (sender, receiver) = channel::bounded(PIPELINE_DEPTH);
+
+        thread::Builder::new()
+            .name("ChainResolve".to_string())
+            .spawn(move || {
+                // `seen_inputs` is carried across the whole fork so cells
+                // consumed by a preceding fork block resolve as dead, the
+                // same way the store transaction would report them after
+                // `attach_block_cell`.
+                let mut seen_inputs = HashSet::new();
+                let mut ancestors: Vec<BlockCellProvider> = Vec::with_capacity(blocks.len());
+                for block in blocks.iter() {
+                    let block_cp = match BlockCellProvider::new(block) {
+                        Ok(block_cp) => block_cp,
+                        Err(err) => {
+                            let _ = sender.send((block.hash(), Err(err)));
+                            return;
+                        }
+                    };
+                    let resolved =
+                        resolve_block(&snapshot, &ancestors, &block_cp, &mut seen_inputs, block);
+                    if sender.send((block.hash(), resolved)).is_err() {
+                        // the verifier is done with the pipeline
+                        return;
+                    }
+                    ancestors.push(block_cp);
+                }
+            })
+            .ok()?;
+
+        Some(ResolvePipeline { receiver })
+    }
+
+    /// Receives the resolution result for the expected block. Returns `None`
+    /// when the pipeline fell out of lockstep or the resolver has gone; the
+    /// caller should then drop the pipeline and resolve in-line.
+    pub(crate) fn recv(
+        &self,
+        expected: &Byte32,
+    ) -> Option<Result<Vec<ResolvedTransaction>, Error>> {
+        match self.receiver.recv() {
+            Ok((hash, result)) if &hash == expected => Some(result),
+            _ => None,
+        }
+    }
+}
@@ -449,6 +449,106 @@ fn test_package_basic() {
     );
 }
 
+#[cfg(not(disable_faketime))]
+#[test]
+fn test_package_append_respects_shrunk_size_limit() {
+    let faketime_file = faketime::millis_tempfile(100_000).expect("create faketime file");
+    ::std::env::set_var("FAKETIME", faketime_file.as_os_str());
+
+    let mut consensus = Consensus::default();
+    consensus.genesis_epoch_ext.set_length(5);
+    let epoch = consensus.genesis_epoch_ext().clone();
+
+    let (chain_controller, shared) = start_chain(Some(consensus));
+
+    let genesis = shared
+        .store()
+        .get_block_header(&shared.store().get_block_hash(0).unwrap())
+        .unwrap();
+    let mut parent_header = genesis;
+    let mut blocks = vec![];
+    for _i in 0..4 {
+        let block = gen_block(&parent_header, 11, &epoch);
+        chain_controller
+            .internal_process_block(Arc::new(block.clone()), Switch::DISABLE_ALL)
+            .expect("process block");
+        parent_header = block.header().to_owned();
+        blocks.push(block);
+    }
+
+    let tx0 = &blocks[0].transactions()[0];
+    let tx1 = build_tx(tx0, &[0], 2);
+    let tx2 = build_tx(&tx1, &[0], 2);
+    let tx3 = build_tx(&tx2, &[0], 2);
+
+    let tx2_0 = &blocks[1].transactions()[0];
+    let tx2_1 = build_tx(tx2_0, &[0], 2);
+    let tx2_2 = build_tx(&tx2_1, &[0], 2);
+    let tx2_3 = build_tx(&tx2_2, &[0], 2);
+
+    let tx_pool = shared.tx_pool_controller();
+    tx_pool
+        .plug_entry(
+            vec![
+                TxEntry::dummy_resolve(tx2_1.clone(), 0, Capacity::shannons(150), 100),
+                TxEntry::dummy_resolve(tx2_2.clone(), 0, Capacity::shannons(150), 100),
+                TxEntry::dummy_resolve(tx2_3.clone(), 0, Capacity::shannons(150), 100),
+            ],
+            PlugTarget::Proposed,
+        )
+        .unwrap();
+
+    // the cached selection fills the txs size budget exactly
+    let bytes_limit = 300 + *BASIC_BLOCK_SIZE;
+    let block_template = tx_pool
+        .get_block_template(Some(bytes_limit), None, None)
+        .unwrap()
+        .unwrap();
+    check_txs(
+        &block_template,
+        vec![&tx2_1, &tx2_2, &tx2_3],
+        "cached selection fills the budget",
+    );
+
+    // a flood of fresh proposals grows the proposals section, shrinking the
+    // txs size budget for the same bytes_limit, while a new proposed entry
+    // invalidates the cached template once its freshness window expires
+    faketime::write_millis(&faketime_file, 104_000).expect("write millis");
+    tx_pool
+        .plug_entry(
+            vec![
+                TxEntry::dummy_resolve(tx1.clone(), 0, Capacity::shannons(1), 100),
+                TxEntry::dummy_resolve(tx2.clone(), 0, Capacity::shannons(1), 100),
+            ],
+            PlugTarget::Pending,
+        )
+        .unwrap();
+    tx_pool
+        .plug_entry(
+            vec![TxEntry::dummy_resolve(
+                tx3.clone(),
+                0,
+                Capacity::shannons(1),
+                100,
+            )],
+            PlugTarget::Proposed,
+        )
+        .unwrap();
+
+    // the cached 300-size selection no longer fits; the incremental append
+    // must give way to a full rescan that sheds an entry instead of
+    // emitting an oversized template
+    let block_template = tx_pool
+        .get_block_template(Some(bytes_limit), None, None)
+        .unwrap()
+        .unwrap();
+    check_txs(
+        &block_template,
+        vec![&tx2_1, &tx2_2],
+        "selection rescanned under the shrunk budget",
+    );
+}
+
 #[test]
 fn test_package_multi_best_scores() {
     let mut consensus = Consensus::default();
@@ -1,13 +1,22 @@
 use ckb_app_config::{ExitCode, ImportArgs};
 use ckb_async_runtime::Handle;
 use ckb_chain::chain::ChainService;
-use ckb_instrument::Import;
+use ckb_instrument::{CellSetSnapshotImport, Import};
 use ckb_launcher::SharedBuilder;
 
 pub fn import(args: ImportArgs, async_handle: Handle) -> Result<(), ExitCode> {
     let builder = SharedBuilder::new(&args.config.db, None, async_handle)?;
     let (shared, mut pack) = builder.consensus(args.consensus).build()?;
 
+    if args.cell_set {
+        return CellSetSnapshotImport::new(shared, args.source)
+            .execute()
+            .map_err(|err| {
+                eprintln!("Import error: {:?}", err);
+                ExitCode::Failure
+            });
+    }
+
     let chain_service = ChainService::new(shared, pack.take_proposal_table());
     let chain_controller = chain_service.start::<&str>(Some("ImportChainService"));
 
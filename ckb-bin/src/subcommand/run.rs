@@ -63,6 +63,7 @@ pub fn run(args: RunArgs, version: Version, async_handle: Handle) -> Result<(),
     exit_handler.wait_for_exit();
 
     info!("Finishing work, please wait...");
+    shared.store().dump_cell_data_cache();
     drop(rpc_server);
 
     Ok(())
@@ -1,10 +1,14 @@
 //! TODO(doc): @quake
-use ckb_db::{ReadOnlyDB, RocksDB};
-use ckb_db_schema::{COLUMN_META, META_TIP_HEADER_KEY, MIGRATION_VERSION_KEY};
+use ckb_db::{Direction, IteratorMode, ReadOnlyDB, RocksDB, RocksDBWriteBatch};
+use ckb_db_schema::{
+    Col, COLUMN_META, META_TIP_HEADER_KEY, MIGRATION_CHECKPOINT_KEY, MIGRATION_VERSION_KEY,
+};
 use ckb_error::{Error, InternalErrorKind};
 use ckb_logger::{error, info};
+use ckb_util::Mutex;
 use console::Term;
 pub use indicatif::{HumanDuration, MultiProgress, ProgressBar, ProgressDrawTarget, ProgressStyle};
+use rayon::prelude::*;
 use std::collections::BTreeMap;
 use std::sync::Arc;
 
@@ -12,6 +16,114 @@ fn internal_error(reason: String) -> Error {
     InternalErrorKind::Database.other(reason).into()
 }
 
+/// Number of leading-byte key ranges a sharded migration is split into.
+const SHARD_COUNT: usize = 256;
+/// Entries staged per write batch before it is flushed.
+const SHARD_BATCH_LIMIT: usize = 100_000;
+
+fn checkpoint_value(version: &str, bitmap: &[u8; SHARD_COUNT / 8]) -> Vec<u8> {
+    let mut value = Vec::with_capacity(version.len() + 1 + bitmap.len());
+    value.extend_from_slice(version.as_bytes());
+    value.push(b':');
+    value.extend_from_slice(bitmap);
+    value
+}
+
+fn load_checkpoint(db: &RocksDB, version: &str) -> Result<[u8; SHARD_COUNT / 8], Error> {
+    let mut bitmap = [0u8; SHARD_COUNT / 8];
+    let raw = db
+        .get_pinned_default(MIGRATION_CHECKPOINT_KEY)
+        .map_err(|err| internal_error(format!("failed to load migration checkpoint: {}", err)))?;
+    if let Some(raw) = raw {
+        let raw = raw.as_ref();
+        // a checkpoint left by a different migration version is stale
+        if raw.len() == version.len() + 1 + bitmap.len()
+            && &raw[..version.len()] == version.as_bytes()
+        {
+            bitmap.copy_from_slice(&raw[version.len() + 1..]);
+        }
+    }
+    Ok(bitmap)
+}
+
+/// Runs `op` over every entry of `col`, with the key space split into
+/// leading-byte ranges processed in parallel across the rayon pool. Writes
+/// staged by `op` are flushed per range every `SHARD_BATCH_LIMIT` entries.
+///
+/// Every completed range is recorded under `MIGRATION_CHECKPOINT_KEY`
+/// (tagged with the migration `version`), so an interrupted migration skips
+/// already-migrated ranges when it is restarted; the caller clears the
+/// checkpoint by bumping the version once the whole migration committed.
+/// The progress bar tracks ranges and reports rate and ETA.
+pub fn migrate_column_sharded(
+    db: &RocksDB,
+    version: &str,
+    col: Col,
+    pb: &ProgressBar,
+    op: &(dyn Fn(&[u8], &[u8], &mut RocksDBWriteBatch) -> Result<(), Error> + Send + Sync),
+) -> Result<(), Error> {
+    let bitmap = load_checkpoint(db, version)?;
+    let done: Vec<u8> = (0..SHARD_COUNT)
+        .filter(|shard| bitmap[shard / 8] & (1 << (shard % 8)) != 0)
+        .map(|shard| shard as u8)
+        .collect();
+    pb.set_length(SHARD_COUNT as u64);
+    pb.set_position(done.len() as u64);
+    pb.set_style(
+        ProgressStyle::default_bar()
+            .template("{prefix:.bold.dim} {bar:40} {pos}/{len} ranges ({per_sec}, eta {eta})"),
+    );
+
+    let checkpoint = Mutex::new(bitmap);
+    (0..SHARD_COUNT as u16)
+        .into_par_iter()
+        .map(|shard| -> Result<(), Error> {
+            let shard = shard as u8;
+            if done.contains(&shard) {
+                return Ok(());
+            }
+
+            let mut next_key = vec![shard];
+            let mut exhausted = false;
+            while !exhausted {
+                let mut wb = db.new_write_batch();
+                let mut crossed = false;
+                let mut callback = |key: &[u8], value: &[u8]| -> Result<(), Error> {
+                    // entries past this range belong to another worker
+                    if key.first() != Some(&shard) {
+                        crossed = true;
+                        return Ok(());
+                    }
+                    op(key, value, &mut wb)
+                };
+                let (_count, nk) = db
+                    .traverse(
+                        col,
+                        &mut callback,
+                        IteratorMode::From(&next_key, Direction::Forward),
+                        SHARD_BATCH_LIMIT,
+                    )
+                    .map_err(|err| internal_error(format!("migration traverse: {}", err)))?;
+                exhausted = crossed || nk.is_empty() || nk.first() != Some(&shard);
+                next_key = nk;
+
+                if !wb.is_empty() {
+                    db.write(&wb)
+                        .map_err(|err| internal_error(format!("migration write: {}", err)))?;
+                }
+            }
+
+            let mut guard = checkpoint.lock();
+            guard[shard as usize / 8] |= 1 << (shard as usize % 8);
+            db.put_default(MIGRATION_CHECKPOINT_KEY, checkpoint_value(version, &guard))
+                .map_err(|err| internal_error(format!("migration checkpoint: {}", err)))?;
+            drop(guard);
+            pb.inc(1);
+            Ok(())
+        })
+        .collect::<Result<(), Error>>()
+}
+
 /// TODO(doc): @quake
 #[derive(Default)]
 pub struct Migrations {
@@ -118,6 +230,12 @@ impl Migrations {
                 .map_err(|err| {
                     internal_error(format!("failed to migrate the database: {}", err))
                 })?;
+            // any in-flight checkpoint belongs to the migration just
+            // completed, clear it
+            db.put_default(MIGRATION_CHECKPOINT_KEY, &[])
+                .map_err(|err| {
+                    internal_error(format!("failed to clear migration checkpoint: {}", err))
+                })?;
         }
         mpb.join_and_clear().expect("MultiProgress join");
         Ok(db)
@@ -359,4 +477,67 @@ mod tests {
             );
         }
     }
+
+    #[test]
+    fn test_sharded_migration_resumes_from_checkpoint() {
+        const COLUMN: &str = "0";
+        const VERSION: &str = "20191127101121";
+
+        let tmp_dir = tempfile::Builder::new()
+            .prefix("test_sharded_migration")
+            .tempdir()
+            .unwrap();
+        let config = DBConfig {
+            path: tmp_dir.as_ref().to_path_buf(),
+            ..Default::default()
+        };
+        let db = RocksDB::open(&config, 1);
+        let txn = db.transaction();
+        for i in 0..1024u32 {
+            let key = i.to_be_bytes();
+            txn.put(COLUMN, &key, &key).unwrap();
+        }
+        txn.commit().unwrap();
+
+        // pretend the upper half of the ranges was already migrated before a
+        // crash; the resumed run must skip them and complete the rest (all
+        // keys here are u32 big-endian, living in range 0)
+        let mut bitmap = [0u8; SHARD_COUNT / 8];
+        for shard in 128..256usize {
+            bitmap[shard / 8] |= 1 << (shard % 8);
+        }
+        db.put_default(MIGRATION_CHECKPOINT_KEY, checkpoint_value(VERSION, &bitmap))
+            .unwrap();
+
+        let pb = ProgressBar::hidden();
+        migrate_column_sharded(&db, VERSION, COLUMN, &pb, &|key, value, wb| {
+            let mut new_value = value.to_vec();
+            new_value.push(1);
+            wb.put(COLUMN, key, &new_value)
+        })
+        .unwrap();
+
+        let mut migrated = 0usize;
+        let mut skipped = 0usize;
+        let mut check = |key: &[u8], value: &[u8]| -> Result<(), Error> {
+            if value.len() == key.len() + 1 {
+                migrated += 1;
+            } else {
+                skipped += 1;
+            }
+            Ok(())
+        };
+        db.full_traverse(COLUMN, &mut check).unwrap();
+        assert_eq!(migrated, 1024);
+        assert_eq!(skipped, 0);
+
+        // checkpoint now marks all shards done; a re-run must not touch data
+        let bitmap = load_checkpoint(&db, VERSION).unwrap();
+        assert!(bitmap.iter().all(|b| *b == 0xff));
+        migrate_column_sharded(&db, VERSION, COLUMN, &pb, &|_key, _value, _wb| {
+            panic!("all ranges are checkpointed, nothing may be re-processed");
+        })
+        .unwrap();
+    }
 }
+
@@ -48,3 +48,6 @@ pub const META_CURRENT_EPOCH_KEY: &[u8] = b"CURRENT_EPOCH";
 pub const CHAIN_SPEC_HASH_KEY: &[u8] = b"chain-spec-hash";
 /// MIGRATION_VERSION_KEY tracks the current database version.
 pub const MIGRATION_VERSION_KEY: &[u8] = b"db-version";
+/// MIGRATION_CHECKPOINT_KEY tracks the progress of an in-flight migration,
+/// so an interrupted migration resumes instead of restarting from scratch.
+pub const MIGRATION_CHECKPOINT_KEY: &[u8] = b"db-version-migrating";
@@ -64,6 +64,9 @@ impl RocksDB {
 
         opts.create_if_missing(true);
         opts.create_missing_column_families(true);
+        if config.pipelined_write {
+            opts.set_enable_pipelined_write(true);
+        }
 
         let db = OptimisticTransactionDB::open_cf_descriptors(&opts, &config.path, cf_descriptors)
             .map_err(|err| internal_error(format!("failed to open database: {}", err)))?;
@@ -2,6 +2,7 @@ use crate::freezer_files::FreezerFiles;
 use crate::internal_error;
 use ckb_error::Error;
 use ckb_types::{
+    bytes::Bytes,
     core::{BlockNumber, BlockView, HeaderView},
     packed,
     prelude::*,
@@ -15,6 +16,8 @@ use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
 use std::sync::Arc;
 
 const LOCKNAME: &str = "FLOCK";
+// number of blocks staged in memory before a vectored append
+const FREEZE_BATCH_SIZE: usize = 32;
 
 /// freeze result represent blkhash -> (blknum, txsnum) btree-map
 /// sorted blkhash for making ranges for compaction
@@ -88,14 +91,54 @@ impl Freezer {
         let mut ret = BTreeMap::new();
         ckb_logger::trace!("freezer freeze start {} threshold {}", number, threshold);
 
+        // blocks are staged and appended in batches so each data file segment
+        // costs one data write and one index write; `ret` and the in-memory
+        // tip only advance once a batch has actually been appended
+        let mut batch: Vec<Bytes> = Vec::with_capacity(FREEZE_BATCH_SIZE);
+        let mut staged: Vec<(BlockNumber, HeaderView, u32)> = Vec::with_capacity(FREEZE_BATCH_SIZE);
+        let mut batch_start = number;
+
+        let flush = |guard: &mut Inner,
+                     ret: &mut FreezeResult,
+                     batch: &mut Vec<Bytes>,
+                     staged: &mut Vec<(BlockNumber, HeaderView, u32)>,
+                     batch_start: &mut BlockNumber|
+         -> Result<(), Error> {
+            if batch.is_empty() {
+                return Ok(());
+            }
+            guard
+                .files
+                .append_batch(*batch_start, batch)
+                .map_err(internal_error)?;
+            *batch_start += batch.len() as u64;
+            batch.clear();
+            for (number, header, txs_count) in staged.drain(..) {
+                ret.insert(header.hash(), (number, txs_count));
+                guard.tip = Some(header);
+            }
+            Ok(())
+        };
+
         for number in number..threshold {
             if self.stopped.load(Ordering::SeqCst) {
+                flush(
+                    &mut guard,
+                    &mut ret,
+                    &mut batch,
+                    &mut staged,
+                    &mut batch_start,
+                )?;
                 guard.files.sync_all().map_err(internal_error)?;
                 return Ok(ret);
             }
 
             if let Some(block) = get_block_by_number(number) {
-                if let Some(ref header) = guard.tip {
+                let expected_parent = staged
+                    .last()
+                    .map(|(_, header, _)| header)
+                    .or_else(|| guard.tip.as_ref());
+                if let Some(header) = expected_parent {
                     if header.hash() != block.header().parent_hash() {
                         return Err(internal_error(format!(
                             "appending unexpected block expected parent_hash {} have {}",
@@ -104,23 +147,31 @@ impl Freezer {
                         )));
                     }
                 }
-                let raw_block = block.data();
-                guard
-                    .files
-                    .append(number, raw_block.as_slice())
-                    .map_err(internal_error)?;
-
-                ret.insert(
-                    block.header().hash(),
-                    (number, block.transactions().len() as u32),
-                );
-                guard.tip = Some(block.header());
+                batch.push(block.data().as_bytes());
+                staged.push((number, block.header(), block.transactions().len() as u32));
                 ckb_logger::trace!("freezer block append {}", number);
+
+                if batch.len() >= FREEZE_BATCH_SIZE {
+                    flush(
+                        &mut guard,
+                        &mut ret,
+                        &mut batch,
+                        &mut staged,
+                        &mut batch_start,
+                    )?;
+                }
             } else {
                 ckb_logger::error!("freezer block missing {}", number);
                 break;
             }
         }
+        flush(
+            &mut guard,
+            &mut ret,
+            &mut batch,
+            &mut staged,
+            &mut batch_start,
+        )?;
         guard.files.sync_all().map_err(internal_error)?;
         Ok(ret)
     }
@@ -134,6 +185,16 @@ impl Freezer {
             .map_err(internal_error)
     }
 
+    /// Retrieves at most `count` consecutive items starting at `start` with
+    /// batched index and data reads.
+    pub fn retrieve_batch(&self, start: BlockNumber, count: u64) -> Result<Vec<Vec<u8>>, Error> {
+        self.inner
+            .lock()
+            .files
+            .retrieve_batch(start, count)
+            .map_err(internal_error)
+    }
+
     /// Return total item number in the freezer
     pub fn number(&self) -> BlockNumber {
         self.number.load(Ordering::SeqCst)
@@ -172,6 +172,98 @@ impl FreezerFiles {
         Ok(())
     }
 
+    /// Appends a batch of consecutive items, buffering the data and the index
+    /// entries so each data file segment costs one data write and one index
+    /// write instead of two writes per item.
+    pub fn append_batch<T: AsRef<[u8]>>(
+        &mut self,
+        start_number: u64,
+        inputs: &[T],
+    ) -> Result<(), IoError> {
+        let expected = self.number.load(Ordering::SeqCst);
+        fail_point!("append-unexpected-number");
+        if expected != start_number {
+            return Err(IoError::new(
+                IoErrorKind::Other,
+                format!(
+                    "appending unexpected block expected {} have {}",
+                    expected, start_number
+                ),
+            ));
+        }
+
+        let mut data_buf: Vec<u8> = Vec::new();
+        let mut index_buf: Vec<u8> = Vec::new();
+        let mut pending: u64 = 0;
+
+        for input in inputs {
+            // https://github.com/rust-lang/rust/issues/49171
+            #[allow(unused_mut)]
+            let mut compressed_data;
+            let mut data: &[u8] = input.as_ref();
+            if self.enable_compression {
+                compressed_data = SnappyEncoder::new().compress_vec(data).map_err(|e| {
+                    IoError::new(IoErrorKind::Other, format!("compress error {}", e))
+                })?;
+                data = &compressed_data;
+            };
+
+            let data_size = data.len();
+            // open a new file, flushing what belongs to the current one first
+            if self.head.bytes + (data_buf.len() + data_size) as u64 > self.max_size {
+                self.flush_batch(&mut data_buf, &mut index_buf, &mut pending)?;
+
+                let head_id = self.head_id;
+                let next_id = head_id + 1;
+                let new_head_file = self.open_truncated(next_id)?;
+
+                // release old head, reopen with read only
+                self.release(head_id);
+                self.open_read_only(head_id)?;
+
+                self.head_id = next_id;
+                self.head = Head::new(new_head_file, 0);
+            }
+
+            data_buf.extend_from_slice(data);
+            let entry = IndexEntry {
+                file_id: self.head_id,
+                offset: self.head.bytes + data_buf.len() as u64,
+            };
+            index_buf.extend_from_slice(&entry.encode());
+            pending += 1;
+
+            //Gauge for tracking the size of all frozen data
+            metrics!(
+                gauge,
+                "ckb-freezer.size",
+                (data_size as i64 + INDEX_ENTRY_SIZE as i64)
+            );
+        }
+
+        self.flush_batch(&mut data_buf, &mut index_buf, &mut pending)
+    }
+
+    fn flush_batch(
+        &mut self,
+        data_buf: &mut Vec<u8>,
+        index_buf: &mut Vec<u8>,
+        pending: &mut u64,
+    ) -> Result<(), IoError> {
+        if *pending == 0 {
+            return Ok(());
+        }
+        self.head.write(data_buf)?;
+        fail_point!("write-index");
+        self.index.seek(SeekFrom::End(0))?;
+        self.index.write_all(index_buf)?;
+        self.number.fetch_add(*pending, Ordering::SeqCst);
+        data_buf.clear();
+        index_buf.clear();
+        *pending = 0;
+        Ok(())
+    }
+
     /// Attempts to sync all OS-internal metadata to disk.
     pub fn sync_all(&self) -> Result<(), IoError> {
         self.head.file.sync_all()?;
@@ -228,23 +320,134 @@ impl FreezerFiles {
         }
     }
 
-    fn get_bounds(&self, item: u64) -> Result<Option<(u64, u64, FileId)>, IoError> {
-        let mut buffer = [0; INDEX_ENTRY_SIZE as usize];
-        let mut index = &self.index;
-        if let Err(e) = index.seek(SeekFrom::Start(item * INDEX_ENTRY_SIZE)) {
-            ckb_logger::trace!("Freezer get_bounds seek {} {}", item * INDEX_ENTRY_SIZE, e);
-            return Ok(None);
+    /// Retrieves `count` consecutive frozen items starting at `start`,
+    /// reading the index once and each data file segment with one contiguous
+    /// read, so serving cold-block ranges avoids per-item seek and
+    /// allocation churn. Returns fewer items when the range crosses the
+    /// freezer boundary.
+    pub fn retrieve_batch(&mut self, start: u64, count: u64) -> Result<Vec<Vec<u8>>, IoError> {
+        if start < 1 || count == 0 {
+            return Ok(Vec::new());
+        }
+        let number = self.number.load(Ordering::SeqCst);
+        if number <= start {
+            return Ok(Vec::new());
         }
+        let end = ::std::cmp::min(start.saturating_add(count), number);
+
+        // load all bounding index entries with a single read; the start
+        // bound of item 1 is the implicit zero offset, mirroring get_bounds
+        let first_pos = ::std::cmp::max(start - 1, 1);
+        let entries_len = (end - first_pos) as usize;
+        let mut raw = vec![0u8; entries_len * INDEX_ENTRY_SIZE as usize];
+        {
+            let mut index = &self.index;
+            if let Err(e) = index.seek(SeekFrom::Start(first_pos * INDEX_ENTRY_SIZE)) {
+                ckb_logger::trace!("Freezer retrieve_batch seek {} {}", first_pos, e);
+                return Ok(Vec::new());
+            }
+            if let Err(e) = index.read_exact(&mut raw) {
+                ckb_logger::trace!("Freezer retrieve_batch read_exact {}", e);
+                return Ok(Vec::new());
+            }
+        }
+        let mut bounds = Vec::with_capacity(entries_len + 1);
+        for chunk in raw.chunks(INDEX_ENTRY_SIZE as usize) {
+            bounds.push(IndexEntry::decode(chunk)?);
+        }
+        if start == 1 {
+            let file_id = bounds[0].file_id;
+            bounds.insert(0, IndexEntry { file_id, offset: 0 });
+        }
+        // bounds[i] is the start bound of item `start + i`, bounds[i + 1]
+        // its end bound
+
+        let total = (end - start) as usize;
+        let mut results: Vec<Vec<u8>> = Vec::with_capacity(total);
+        let mut i = 0usize;
+        while i < total {
+            // group consecutive items living in the same data file; an item
+            // whose bounds disagree on the file starts at offset 0 of the
+            // end bound's file
+            let file_id = bounds[i + 1].file_id;
+            let seg_start = if bounds[i].file_id == file_id {
+                bounds[i].offset
+            } else {
+                0
+            };
+            let mut j = i + 1;
+            while j < total && bounds[j + 1].file_id == file_id {
+                j += 1;
+            }
+            let seg_end = bounds[j].offset;
+
+            let size = (seg_end - seg_start) as usize;
+            let mut seg_data = vec![0u8; size];
+            {
+                let open_read_only;
+                let mut file = if let Some(file) = self.files.get(&file_id) {
+                    file
+                } else {
+                    open_read_only = self.open_read_only(file_id)?;
+                    &open_read_only
+                };
+                file.seek(SeekFrom::Start(seg_start))?;
+                file.read_exact(&mut seg_data)?;
+            }
 
-        if let Err(e) = index.read_exact(&mut buffer) {
-            ckb_logger::trace!("Freezer get_bounds read_exact {}", e);
-            return Ok(None);
+            // Meter for measuring the effective amount of data read
+            metrics!(
+                counter,
+                "ckb-freezer.read",
+                (size as u64 + 2 * INDEX_ENTRY_SIZE)
+            );
+
+            for k in i..j {
+                let item_start = if k == i { seg_start } else { bounds[k].offset };
+                let item_end = bounds[k + 1].offset;
+                let slice =
+                    &seg_data[(item_start - seg_start) as usize..(item_end - seg_start) as usize];
+                let data = if self.enable_compression {
+                    SnappyDecoder::new().decompress_vec(slice).map_err(|e| {
+                        IoError::new(
+                            IoErrorKind::Other,
+                            format!(
+                                "decompress file-id-{} offset-{} size-{}: error {}",
+                                file_id,
+                                item_start,
+                                slice.len(),
+                                e
+                            ),
+                        )
+                    })?
+                } else {
+                    slice.to_vec()
+                };
+                results.push(data);
+            }
+            i = j;
         }
-        let end_index = IndexEntry::decode(&buffer)?;
+        Ok(results)
+    }
+
+    fn get_bounds(&self, item: u64) -> Result<Option<(u64, u64, FileId)>, IoError> {
+        let mut index = &self.index;
         if item == 1 {
+            let mut buffer = [0; INDEX_ENTRY_SIZE as usize];
+            if let Err(e) = index.seek(SeekFrom::Start(item * INDEX_ENTRY_SIZE)) {
+                ckb_logger::trace!("Freezer get_bounds seek {} {}", item * INDEX_ENTRY_SIZE, e);
+                return Ok(None);
+            }
+            if let Err(e) = index.read_exact(&mut buffer) {
+                ckb_logger::trace!("Freezer get_bounds read_exact {}", e);
+                return Ok(None);
+            }
+            let end_index = IndexEntry::decode(&buffer)?;
             return Ok(Some((0, end_index.offset, end_index.file_id)));
         }
 
+        // the two bounding entries are adjacent, read them with one seek
+        let mut buffer = [0; 2 * INDEX_ENTRY_SIZE as usize];
         if let Err(e) = index.seek(SeekFrom::Start((item - 1) * INDEX_ENTRY_SIZE)) {
             ckb_logger::trace!(
                 "Freezer get_bounds seek {} {}",
@@ -257,7 +460,8 @@ impl FreezerFiles {
             ckb_logger::trace!("Freezer get_bounds read_exact {}", e);
             return Ok(None);
         }
-        let start_index = IndexEntry::decode(&buffer)?;
+        let start_index = IndexEntry::decode(&buffer[..INDEX_ENTRY_SIZE as usize])?;
+        let end_index = IndexEntry::decode(&buffer[INDEX_ENTRY_SIZE as usize..])?;
         if start_index.file_id != end_index.file_id {
             return Ok(Some((0, end_index.offset, end_index.file_id)));
         }
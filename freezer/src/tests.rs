@@ -285,3 +285,48 @@ fn open_files_limit_retrieve() {
         assert_eq!(Some(expect), actual);
     }
 }
+
+#[test]
+fn batch_append_retrieve() {
+    let tempdir = tempfile::Builder::new().tempdir().unwrap();
+
+    let mut freezer = FreezerFilesBuilder::new(tempdir.path().to_path_buf())
+        .max_file_size(50)
+        .build()
+        .unwrap();
+    freezer.preopen().unwrap();
+
+    let batch: Vec<Vec<u8>> = (1..100).map(|i| make_bytes(15, i)).collect();
+    freezer.append_batch(1, &batch).unwrap();
+    assert_eq!(freezer.number(), 100);
+
+    // batch and single retrieval agree, including across data files
+    for i in 1..100 {
+        let expect = make_bytes(15, i);
+        let actual = freezer.retrieve(i.into()).unwrap();
+        assert_eq!(Some(expect), actual);
+    }
+    let actual = freezer.retrieve_batch(1, 99).unwrap();
+    assert_eq!(batch, actual);
+    let actual = freezer.retrieve_batch(40, 20).unwrap();
+    assert_eq!(&batch[39..59], &actual[..]);
+
+    // interleaves with single appends
+    for i in 100..120 {
+        let data = make_bytes(15, i);
+        freezer.append(i.into(), &data).unwrap();
+    }
+    let batch: Vec<Vec<u8>> = (120..255).map(|i| make_bytes(15, i)).collect();
+    freezer.append_batch(120, &batch).unwrap();
+
+    let actual = freezer.retrieve_batch(1, 300).unwrap();
+    let expect: Vec<Vec<u8>> = (1..255).map(|i| make_bytes(15, i)).collect();
+    assert_eq!(expect, actual);
+
+    // out-of-bound ranges are clamped or empty
+    assert_eq!(freezer.retrieve_batch(255, 10).unwrap(), Vec::<Vec<u8>>::new());
+    assert_eq!(freezer.retrieve_batch(0, 10).unwrap(), Vec::<Vec<u8>>::new());
+
+    let err = freezer.append_batch(1, &[make_bytes(15, 1)]).unwrap_err();
+    assert!(err.to_string().contains("appending unexpected block"));
+}
@@ -67,6 +67,16 @@ pub fn pow_message(pow_hash: &Byte32, nonce: u128) -> [u8; 48] {
 pub trait PowEngine: Send + Sync + AsAny {
     /// TODO(doc): @quake
     fn verify(&self, header: &Header) -> bool;
+
+    /// Verifies a batch of headers, returning one verdict per header.
+    ///
+    /// The default implementation verifies sequentially. An engine whose
+    /// hash permutation vectorizes (running several independent states per
+    /// instruction stream) can override this to amortize the batch, which
+    /// is why the headers-sync path hands headers over in chunks.
+    fn verify_many(&self, headers: &[Header]) -> Vec<bool> {
+        headers.iter().map(|header| self.verify(header)).collect()
+    }
 }
 
 /// TODO(doc): @quake
@@ -647,6 +647,24 @@ fn test_rpc_examples() {
     }
 }
 
+// A range entirely above the tip is well-formed and must yield an empty
+// list, not an error (and not an arithmetic panic under overflow-checks).
+#[test]
+fn test_get_blocks_in_range_above_tip() {
+    let suite = setup_rpc_test_suite(TARGET_HEIGHT);
+    let response = suite.rpc(&RpcTestRequest {
+        id: 42,
+        jsonrpc: "2.0".to_string(),
+        method: "get_blocks_in_range".to_string(),
+        params: vec![
+            json!(format!("{:#x}", TARGET_HEIGHT + 1)),
+            json!(format!("{:#x}", TARGET_HEIGHT + 1)),
+        ],
+    });
+    assert!(response.error.is_null(), "error: {}", response.error);
+    assert_eq!(response.result, json!([]));
+}
+
 fn replace_rpc_response<T>(example: &RpcTestExample, response: &mut RpcTestResponse)
 where
     T: DeserializeOwned,
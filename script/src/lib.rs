@@ -2,6 +2,7 @@
 pub mod cost_model;
 mod error;
 mod ill_transaction_checker;
+mod recognized;
 mod syscalls;
 mod type_id;
 mod types;
@@ -10,6 +11,10 @@ mod verify_env;
 
 pub use crate::error::{ScriptError, TransactionScriptError};
 pub use crate::ill_transaction_checker::IllTransactionChecker;
+pub use crate::recognized::{
+    extract_sighash_all_entries, SighashAllEntry, SIGHASH_ALL_PUBKEY_HASH_LEN,
+    SIGHASH_ALL_SIGNATURE_LEN,
+};
 pub use crate::types::{
     CoreMachine, ScriptGroup, ScriptGroupType, ScriptVersion, TransactionSnapshot,
     TransactionState, VerifyResult, VmIsa, VmVersion,
@@ -0,0 +1,159 @@
+//! Native recognition of the well-known secp256k1_blake160_sighash_all lock.
+//!
+//! The system lock backing the vast majority of mainnet transactions has a
+//! fixed, well-understood algorithm: blake2b over the transaction hash and
+//! witnesses, then a recoverable secp256k1 signature check against the
+//! blake160 public key hash in the script args. When the script group has the
+//! canonical shape, that check can be replayed natively at a tiny fraction of
+//! the VM cost, and many checks can be batched across a whole block.
+//!
+//! Recognition is deliberately strict: anything but the canonical shape
+//! (20-byte args, first group witness a `WitnessArgs` with a 65-byte lock
+//! field) yields no entry and the group must be handled as any other script.
+//! For recognized groups the computed digest matches the script byte for
+//! byte, so a passing native check implies a passing script run; callers must
+//! still confirm native *failures* through the VM before rejecting anything.
+
+use ckb_chain_spec::consensus::Consensus;
+use ckb_crypto::secp::{Message, Signature};
+use ckb_hash::{blake2b_256, new_blake2b};
+use ckb_types::{
+    bytes::Bytes,
+    core::{cell::ResolvedTransaction, ScriptHashType, TransactionView},
+    packed::{Byte32, Script, WitnessArgs},
+    prelude::*,
+};
+use std::collections::HashMap;
+use std::convert::TryFrom;
+
+/// Length of the recoverable signature carried in the witness lock field.
+pub const SIGHASH_ALL_SIGNATURE_LEN: usize = 65;
+/// Length of the blake160 public key hash carried in the script args.
+pub const SIGHASH_ALL_PUBKEY_HASH_LEN: usize = 20;
+
+/// A signature check extracted from a recognized
+/// secp256k1_blake160_sighash_all lock group.
+pub struct SighashAllEntry {
+    /// The signed digest, blake2b over the tx hash and witnesses.
+    pub message: [u8; 32],
+    /// The recoverable signature from the first group witness' lock field.
+    pub signature: [u8; SIGHASH_ALL_SIGNATURE_LEN],
+    /// blake160 of the expected compressed public key, the script args.
+    pub pubkey_hash: [u8; SIGHASH_ALL_PUBKEY_HASH_LEN],
+}
+
+impl SighashAllEntry {
+    /// Runs the native check: recovers the public key from the signature and
+    /// compares its blake160 against the script args.
+    pub fn verify(&self) -> bool {
+        let signature = Signature::from_slice(&self.signature[..]);
+        let pubkey = match signature.and_then(|sig| sig.recover(&Message::from(self.message))) {
+            Ok(pubkey) => pubkey,
+            Err(_) => return false,
+        };
+        blake2b_256(&pubkey.serialize())[..SIGHASH_ALL_PUBKEY_HASH_LEN] == self.pubkey_hash[..]
+    }
+}
+
+/// Extracts native signature checks for every lock group of `rtx` recognized
+/// as the well-known secp256k1_blake160_sighash_all script, identified by the
+/// type script hash recorded in the consensus. Unrecognized groups simply
+/// yield no entry.
+pub fn extract_sighash_all_entries(
+    rtx: &ResolvedTransaction,
+    consensus: &Consensus,
+) -> Vec<SighashAllEntry> {
+    let recognized_code_hash = match consensus.secp256k1_blake160_sighash_all_type_hash() {
+        Some(hash) => hash,
+        None => return Vec::new(),
+    };
+
+    // group input indices by lock, the same grouping the script verifier uses
+    let mut group_order: Vec<Byte32> = Vec::new();
+    let mut groups: HashMap<Byte32, (Script, Vec<usize>)> = HashMap::default();
+    for (i, cell_meta) in rtx.resolved_inputs.iter().enumerate() {
+        let output = &cell_meta.cell_output;
+        let lock_hash = output.calc_lock_hash();
+        groups
+            .entry(lock_hash.clone())
+            .or_insert_with(|| {
+                group_order.push(lock_hash);
+                (output.lock(), Vec::new())
+            })
+            .1
+            .push(i);
+    }
+
+    group_order
+        .iter()
+        .filter_map(|lock_hash| {
+            let (script, indices) = &groups[lock_hash];
+            if script.code_hash() != recognized_code_hash
+                || ScriptHashType::try_from(script.hash_type()).ok()? != ScriptHashType::Type
+            {
+                return None;
+            }
+            extract_entry(&rtx.transaction, script, indices)
+        })
+        .collect()
+}
+
+fn extract_entry(
+    tx: &TransactionView,
+    script: &Script,
+    indices: &[usize],
+) -> Option<SighashAllEntry> {
+    let args = script.args().raw_data();
+    if args.len() != SIGHASH_ALL_PUBKEY_HASH_LEN {
+        return None;
+    }
+
+    let witnesses = tx.witnesses();
+    let first_witness_bytes = witnesses.get(*indices.first()?)?.raw_data();
+    let witness_args = WitnessArgs::from_slice(&first_witness_bytes).ok()?;
+    let lock_field = witness_args.lock().to_opt()?.raw_data();
+    if lock_field.len() != SIGHASH_ALL_SIGNATURE_LEN {
+        return None;
+    }
+
+    // zero the lock field keeping the witness layout identical, the same
+    // transformation the script applies before hashing
+    let zeroed_witness = witness_args
+        .as_builder()
+        .lock(Some(Bytes::from(vec![0u8; SIGHASH_ALL_SIGNATURE_LEN])).pack())
+        .build()
+        .as_bytes();
+
+    let mut blake2b = new_blake2b();
+    let mut message = [0u8; 32];
+    blake2b.update(&tx.hash().raw_data());
+    blake2b.update(&(zeroed_witness.len() as u64).to_le_bytes());
+    blake2b.update(&zeroed_witness);
+    for &index in indices.iter().skip(1) {
+        match witnesses.get(index) {
+            Some(witness) => {
+                let data = witness.raw_data();
+                blake2b.update(&(data.len() as u64).to_le_bytes());
+                blake2b.update(&data);
+            }
+            // the script stops at the first out-of-bound group witness
+            None => break,
+        }
+    }
+    for index in tx.inputs().len()..witnesses.len() {
+        let data = witnesses.get(index).expect("checked len").raw_data();
+        blake2b.update(&(data.len() as u64).to_le_bytes());
+        blake2b.update(&data);
+    }
+    blake2b.finalize(&mut message);
+
+    let mut signature = [0u8; SIGHASH_ALL_SIGNATURE_LEN];
+    signature.copy_from_slice(&lock_field);
+    let mut pubkey_hash = [0u8; SIGHASH_ALL_PUBKEY_HASH_LEN];
+    pubkey_hash.copy_from_slice(&args);
+    Some(SighashAllEntry {
+        message,
+        signature,
+        pubkey_hash,
+    })
+}
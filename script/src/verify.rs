@@ -39,6 +39,10 @@ use ckb_vm::machine::asm::AsmMachine;
 #[cfg(not(has_asm))]
 use ckb_vm::TraceMachine;
 
+use ckb_util::Mutex;
+use lru::LruCache;
+use once_cell::sync::Lazy;
+use rayon::iter::{IntoParallelRefIterator, ParallelIterator};
 use std::cell::RefCell;
 use std::collections::HashMap;
 use std::convert::TryFrom;
@@ -51,6 +55,17 @@ pub enum ChunkState<'a> {
     Completed(Cycle),
 }
 
+// Number of script binaries kept in the process-wide code cache. A handful
+// of system scripts back the overwhelming majority of transactions, so a
+// small cache eliminates almost every repeated dep-cell read.
+const SCRIPT_CODE_CACHE_SIZE: usize = 64;
+
+/// Process-wide cache of script binaries keyed by data hash, shared across
+/// all verifier instances. `Bytes` is reference counted, so hits hand every
+/// VM the same underlying buffer instead of re-reading it from the store.
+static SCRIPT_CODE_CACHE: Lazy<Mutex<LruCache<Byte32, Bytes>>> =
+    Lazy::new(|| Mutex::new(LruCache::new(SCRIPT_CODE_CACHE_SIZE)));
+
 #[derive(Debug, PartialEq, Eq, Clone)]
 enum DataGurad {
     NotLoaded(OutPoint),
@@ -82,6 +97,30 @@ impl LazyData {
             DataGurad::Loaded(bytes) => bytes,
         }
     }
+
+    /// Like `access`, but consults the process-wide script code cache keyed
+    /// by `data_hash` before falling back to the data loader, and populates
+    /// it on a miss.
+    fn access_cached<DL: CellDataProvider>(&self, data_loader: &DL, data_hash: &Byte32) -> Bytes {
+        let guard = self.0.borrow().to_owned();
+        match guard {
+            DataGurad::NotLoaded(out_point) => {
+                // the guard must not be held across the loader fall-back
+                let cached = SCRIPT_CODE_CACHE.lock().get(data_hash).cloned();
+                let data = match cached {
+                    Some(data) => data,
+                    None => {
+                        let data = data_loader.get_cell_data(&out_point).expect("cell data");
+                        SCRIPT_CODE_CACHE.lock().put(data_hash.clone(), data.clone());
+                        data
+                    }
+                };
+                self.0.replace(DataGurad::Loaded(data.clone()));
+                data
+            }
+            DataGurad::Loaded(bytes) => bytes,
+        }
+    }
 }
 
 #[derive(Debug, PartialEq, Eq, Clone)]
@@ -368,7 +407,7 @@ impl<'a, DL: CellDataProvider + HeaderProvider> TransactionScriptsVerifier<'a, D
         match script_hash_type {
             ScriptHashType::Data | ScriptHashType::Data1 => {
                 if let Some(lazy) = self.binaries_by_data_hash.get(&script.code_hash()) {
-                    Ok(lazy.access(self.data_loader))
+                    Ok(lazy.access_cached(self.data_loader, &script.code_hash()))
                 } else {
                     Err(ScriptError::InvalidCodeHash)
                 }
@@ -376,8 +415,10 @@ impl<'a, DL: CellDataProvider + HeaderProvider> TransactionScriptsVerifier<'a, D
             ScriptHashType::Type => {
                 if let Some(ref bin) = self.binaries_by_type_hash.get(&script.code_hash()) {
                     match bin {
-                        Binaries::Unique((_, ref lazy)) => Ok(lazy.access(self.data_loader)),
-                        Binaries::Duplicate((_, ref lazy)) => {
+                        Binaries::Unique((ref data_hash, ref lazy)) => {
+                            Ok(lazy.access_cached(self.data_loader, data_hash))
+                        }
+                        Binaries::Duplicate((ref data_hash, ref lazy)) => {
                             let proposal_window = self.consensus.tx_proposal_window();
                             let epoch_number = self.tx_env.epoch_number(proposal_window);
                             if self
@@ -385,7 +426,7 @@ impl<'a, DL: CellDataProvider + HeaderProvider> TransactionScriptsVerifier<'a, D
                                 .hardfork_switch()
                                 .is_allow_multiple_matches_on_identical_data_enabled(epoch_number)
                             {
-                                Ok(lazy.access(self.data_loader))
+                                Ok(lazy.access_cached(self.data_loader, data_hash))
                             } else {
                                 Err(ScriptError::MultipleMatches)
                             }
@@ -461,6 +502,84 @@ impl<'a, DL: CellDataProvider + HeaderProvider> TransactionScriptsVerifier<'a, D
         Ok(cycles)
     }
 
+    /// Verifies the transaction by running script groups in parallel.
+    ///
+    /// Script groups are independent of each other, so they can be scheduled
+    /// across a worker pool. Unlike [`verify`](#method.verify), every group is
+    /// given the whole `max_cycles` budget and the aggregate limit is enforced
+    /// after all groups complete, the same strategy the contextual block
+    /// verifier uses for cross-transaction parallelism. The accepted
+    /// transaction set is identical to the sequential path: the returned total
+    /// is the exact sum of per-group consumed cycles, and any transaction
+    /// exceeding `max_cycles` in aggregate is still rejected.
+    ///
+    /// Note the verifier itself holds lazily loaded binaries behind interior
+    /// mutability and cannot be shared across threads, so each worker builds
+    /// its own verifier over the shared borrows; the custom debug printer, if
+    /// any, is not propagated to workers.
+    ///
+    /// ## Params
+    ///
+    /// * `max_cycles` - Maximium allowed cycles to run the scripts.
+    ///
+    /// ## Returns
+    ///
+    /// It returns the total consumed cycles on success, Otherwise it returns the verification error.
+    pub fn verify_parallel(&self, max_cycles: Cycle) -> Result<Cycle, Error>
+    where
+        DL: Sync,
+    {
+        let group_keys: Vec<(ScriptGroupType, Byte32)> = self
+            .groups()
+            .map(|(ty, hash, _group)| (ty, hash.to_owned()))
+            .collect();
+
+        // parallelism pays off only when there is more than one group
+        if group_keys.len() <= 1 {
+            return self.verify(max_cycles);
+        }
+
+        let rtx = self.rtx;
+        let consensus = self.consensus;
+        let data_loader = self.data_loader;
+        let tx_env = self.tx_env;
+
+        let group_cycles = group_keys
+            .par_iter()
+            .map(|(ty, hash)| {
+                let verifier = TransactionScriptsVerifier::new(rtx, consensus, data_loader, tx_env);
+                let group = verifier
+                    .find_script_group(*ty, hash)
+                    .expect("script groups built from the same transaction");
+                verifier
+                    .verify_script_group(group, max_cycles)
+                    .map_err(|e| {
+                        #[cfg(feature = "logging")]
+                        info!(
+                            "Error validating script group {} of transaction {}: {}",
+                            hash,
+                            verifier.hash(),
+                            e
+                        );
+                        e.source(group).into()
+                    })
+            })
+            .collect::<Result<Vec<Cycle>, Error>>()?;
+
+        let mut cycles: Cycle = 0;
+        for used_cycles in group_cycles {
+            cycles = cycles
+                .checked_add(used_cycles)
+                .ok_or_else(|| ScriptError::CyclesOverflow(cycles, used_cycles).unknown_source())?;
+        }
+        if cycles > max_cycles {
+            return Err(ScriptError::ExceededMaximumCycles(max_cycles)
+                .unknown_source()
+                .into());
+        }
+        Ok(cycles)
+    }
+
     fn build_state(
         &self,
         vm: ResumableMachine<'a>,
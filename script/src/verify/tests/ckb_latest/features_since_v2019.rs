@@ -1262,3 +1262,230 @@ fn check_typical_secp256k1_blake160_2_in_2_out_tx() {
     assert!(cycle <= TWO_IN_TWO_OUT_CYCLES);
     assert!(cycle >= TWO_IN_TWO_OUT_CYCLES - CYCLE_BOUND);
 }
+
+mod sighash_all_native_equivalence {
+    //! Equivalence between `SighashAllEntry::verify` and the real
+    //! secp256k1_blake160_sighash_all lock run in the VM: for recognized
+    //! groups a passing native check must imply a passing script run and a
+    //! failing script run must fail natively as well.
+    use super::*;
+    use crate::{extract_sighash_all_entries, SighashAllEntry};
+    use ckb_types::bytes::Bytes;
+    use ckb_types::core::cell::ResolvedTransaction;
+    use ckb_types::core::TransactionView;
+    use ckb_types::packed::CellOutput;
+
+    fn secp_lock(privkey: &Privkey) -> Script {
+        let pubkey_data = privkey.pubkey().expect("pubkey").serialize();
+        let lock_arg = Bytes::from((&blake2b_256(&pubkey_data)[0..20]).to_owned());
+        Script::new_builder()
+            .args(lock_arg.pack())
+            .code_hash(type_lock_script_code_hash().pack())
+            .hash_type(ScriptHashType::Type.into())
+            .build()
+    }
+
+    // blake2b over the tx hash and witnesses, the way the script hashes a
+    // group whose first input index is `first`: the first group witness with
+    // a zeroed lock field, the remaining group witnesses, then every witness
+    // past the input count
+    fn sign_group_witness(
+        tx: &TransactionView,
+        privkey: &Privkey,
+        first: usize,
+        rest: &[usize],
+    ) -> WitnessArgs {
+        let witnesses = tx.witnesses();
+        let zeroed = WitnessArgs::from_slice(&witnesses.get(first).expect("witness").raw_data())
+            .expect("witness args")
+            .as_builder()
+            .lock(Some(Bytes::from(vec![0u8; 65])).pack())
+            .build()
+            .as_bytes();
+        let mut hasher = new_blake2b();
+        hasher.update(&tx.hash().raw_data());
+        hasher.update(&(zeroed.len() as u64).to_le_bytes());
+        hasher.update(&zeroed);
+        for &index in rest {
+            if let Some(witness) = witnesses.get(index) {
+                let data = witness.raw_data();
+                hasher.update(&(data.len() as u64).to_le_bytes());
+                hasher.update(&data);
+            }
+        }
+        for index in tx.inputs().len()..witnesses.len() {
+            let data = witnesses.get(index).expect("extra witness").raw_data();
+            hasher.update(&(data.len() as u64).to_le_bytes());
+            hasher.update(&data);
+        }
+        let message = {
+            let mut buf = [0u8; 32];
+            hasher.finalize(&mut buf);
+            H256::from(buf)
+        };
+        let sig = privkey.sign_recoverable(&message).expect("sign");
+        WitnessArgs::new_builder()
+            .lock(Some(Bytes::from(sig.serialize())).pack())
+            .build()
+    }
+
+    fn resolve(tx: TransactionView, locks: &[Script]) -> ResolvedTransaction {
+        let consensus = ckb_testnet_consensus();
+        let (secp_cell, secp_cell_data) = secp256k1_blake160_sighash_cell(consensus.clone());
+        let (data_cell, data_cell_data) = secp256k1_data_cell(consensus);
+        let resolved_inputs = locks
+            .iter()
+            .zip(tx.inputs().into_iter())
+            .map(|(lock, input)| {
+                let cell = CellOutput::new_builder()
+                    .capacity(capacity_bytes!(100).pack())
+                    .lock(lock.clone())
+                    .build();
+                CellMetaBuilder::from_cell_output(cell, Default::default())
+                    .out_point(input.previous_output())
+                    .build()
+            })
+            .collect();
+        ResolvedTransaction {
+            transaction: tx,
+            resolved_cell_deps: vec![
+                CellMetaBuilder::from_cell_output(secp_cell, secp_cell_data).build(),
+                CellMetaBuilder::from_cell_output(data_cell, data_cell_data).build(),
+            ],
+            resolved_inputs,
+            resolved_dep_groups: vec![],
+        }
+    }
+
+    // Runs the VM and the native extraction over the same resolved
+    // transaction and asserts they agree; returns the VM verdict.
+    fn assert_equivalence(rtx: &ResolvedTransaction, expected_groups: usize) -> bool {
+        let consensus = ckb_testnet_consensus();
+        let entries = extract_sighash_all_entries(rtx, &consensus);
+        assert_eq!(
+            entries.len(),
+            expected_groups,
+            "all groups must be recognized"
+        );
+        let native_ok = entries.iter().all(SighashAllEntry::verify);
+
+        let verifier = TransactionScriptsVerifierWithEnv::new();
+        let vm_ok = verifier
+            .verify(SCRIPT_VERSION, rtx, TWO_IN_TWO_OUT_CYCLES)
+            .is_ok();
+
+        assert_eq!(
+            native_ok, vm_ok,
+            "native sighash check must agree with the VM"
+        );
+        vm_ok
+    }
+
+    fn build_unsigned(inputs_count: usize, witnesses: Vec<Bytes>) -> TransactionView {
+        let dep_group_tx_hash = ckb_testnet_consensus().genesis_block().transactions()[1].hash();
+        let cell_dep = CellDep::new_builder()
+            .out_point(OutPoint::new(dep_group_tx_hash, 0))
+            .dep_type(DepType::DepGroup.into())
+            .build();
+        TransactionBuilder::default()
+            .cell_dep(cell_dep)
+            .inputs((0..inputs_count).map(|i| {
+                CellInput::new(OutPoint::new(h256!("0x1234").pack(), i as u32), 0)
+            }))
+            .witnesses(witnesses.into_iter().map(|w| w.pack()))
+            .build()
+    }
+
+    #[test]
+    fn multi_input_groups_with_extra_witness() {
+        let mut generator = Generator::non_crypto_safe_prng(42);
+        let privkey_a = generator.gen_privkey();
+        let privkey_b = generator.gen_privkey();
+        let lock_a = secp_lock(&privkey_a);
+        let lock_b = secp_lock(&privkey_b);
+        let locks = vec![lock_a.clone(), lock_a, lock_b];
+
+        // inputs 0 and 1 share lock a, input 2 uses lock b; witness 1 is a
+        // non-WitnessArgs group witness and witness 3 lies past the inputs
+        let placeholder = WitnessArgs::new_builder()
+            .lock(Some(Bytes::from(vec![0u8; 65])).pack())
+            .build()
+            .as_bytes();
+        let tx = build_unsigned(
+            3,
+            vec![
+                placeholder.clone(),
+                Bytes::from(vec![7u8; 11]),
+                placeholder,
+                Bytes::from(vec![9u8; 5]),
+            ],
+        );
+
+        let witness_a = sign_group_witness(&tx, &privkey_a, 0, &[1]);
+        let witness_b = sign_group_witness(&tx, &privkey_b, 2, &[]);
+        let tx = tx
+            .as_advanced_builder()
+            .set_witnesses(vec![
+                witness_a.as_bytes().pack(),
+                Bytes::from(vec![7u8; 11]).pack(),
+                witness_b.as_bytes().pack(),
+                Bytes::from(vec![9u8; 5]).pack(),
+            ])
+            .build();
+
+        let rtx = resolve(tx, &locks);
+        assert!(assert_equivalence(&rtx, 2), "signed tx must pass");
+    }
+
+    #[test]
+    fn witnesses_shorter_than_inputs() {
+        let mut generator = Generator::non_crypto_safe_prng(43);
+        let privkey = generator.gen_privkey();
+        let lock = secp_lock(&privkey);
+        let locks = vec![lock.clone(), lock];
+
+        // two inputs in one group, a single witness: the script stops at the
+        // first missing group witness
+        let placeholder = WitnessArgs::new_builder()
+            .lock(Some(Bytes::from(vec![0u8; 65])).pack())
+            .build()
+            .as_bytes();
+        let tx = build_unsigned(2, vec![placeholder]);
+        let witness = sign_group_witness(&tx, &privkey, 0, &[1]);
+        let tx = tx
+            .as_advanced_builder()
+            .set_witnesses(vec![witness.as_bytes().pack()])
+            .build();
+
+        let rtx = resolve(tx, &locks);
+        assert!(assert_equivalence(&rtx, 1), "signed tx must pass");
+    }
+
+    #[test]
+    fn corrupted_signature_rejected_by_both() {
+        let mut generator = Generator::non_crypto_safe_prng(44);
+        let privkey = generator.gen_privkey();
+        let lock = secp_lock(&privkey);
+        let locks = vec![lock];
+
+        let placeholder = WitnessArgs::new_builder()
+            .lock(Some(Bytes::from(vec![0u8; 65])).pack())
+            .build()
+            .as_bytes();
+        let tx = build_unsigned(1, vec![placeholder]);
+        let witness = sign_group_witness(&tx, &privkey, 0, &[]);
+        let mut sig = witness.lock().to_opt().expect("lock").raw_data().to_vec();
+        sig[10] ^= 1;
+        let witness = witness
+            .as_builder()
+            .lock(Some(Bytes::from(sig)).pack())
+            .build();
+        let tx = tx
+            .as_advanced_builder()
+            .set_witnesses(vec![witness.as_bytes().pack()])
+            .build();
+
+        let rtx = resolve(tx, &locks);
+        assert!(!assert_equivalence(&rtx, 1), "corrupted tx must fail");
+    }
+}
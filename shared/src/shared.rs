@@ -14,9 +14,9 @@ use ckb_notify::NotifyController;
 use ckb_proposal_table::ProposalView;
 use ckb_stop_handler::{SignalSender, StopHandler};
 use ckb_store::{ChainDB, ChainStore};
-use ckb_tx_pool::{TokioRwLock, TxPoolController};
+use ckb_tx_pool::TxPoolController;
 use ckb_types::{
-    core::{service, BlockNumber, EpochExt, EpochNumber, HeaderView},
+    core::{service, BlockNumber, EpochExt, EpochNumber, FeeRate, HeaderView},
     packed::{self, Byte32},
     prelude::*,
     U256,
@@ -53,12 +53,12 @@ pub struct Shared {
     pub(crate) store: ChainDB,
     pub(crate) tx_pool_controller: TxPoolController,
     pub(crate) notify_controller: NotifyController,
-    pub(crate) txs_verify_cache: Arc<TokioRwLock<TxVerificationCache>>,
+    pub(crate) txs_verify_cache: Arc<TxVerificationCache>,
     pub(crate) consensus: Arc<Consensus>,
     pub(crate) snapshot_mgr: Arc<SnapshotMgr>,
     pub(crate) async_handle: Handle,
     pub(crate) ibd_finished: Arc<AtomicBool>,
-    pub(crate) relay_tx_sender: Sender<(Option<PeerIndex>, bool, Byte32)>,
+    pub(crate) relay_tx_sender: Sender<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
 }
 
 impl Shared {
@@ -68,12 +68,12 @@ impl Shared {
         store: ChainDB,
         tx_pool_controller: TxPoolController,
         notify_controller: NotifyController,
-        txs_verify_cache: Arc<TokioRwLock<TxVerificationCache>>,
+        txs_verify_cache: Arc<TxVerificationCache>,
         consensus: Arc<Consensus>,
         snapshot_mgr: Arc<SnapshotMgr>,
         async_handle: Handle,
         ibd_finished: Arc<AtomicBool>,
-        relay_tx_sender: Sender<(Option<PeerIndex>, bool, Byte32)>,
+        relay_tx_sender: Sender<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
     ) -> Shared {
         Shared {
             store,
@@ -277,7 +277,7 @@ impl Shared {
     }
 
     /// TODO(doc): @quake
-    pub fn txs_verify_cache(&self) -> Arc<TokioRwLock<TxVerificationCache>> {
+    pub fn txs_verify_cache(&self) -> Arc<TxVerificationCache> {
         Arc::clone(&self.txs_verify_cache)
     }
 
@@ -2,10 +2,21 @@ use ckb_app_config::StoreConfig;
 use ckb_types::{
     bytes::Bytes,
     core::{HeaderView, UncleBlockVecView},
-    packed::{self, Byte32, ProposalShortIdVec},
+    packed::{self, Byte32, CellOutput, ProposalShortIdVec},
+    prelude::*,
 };
 use ckb_util::Mutex;
 use lru::LruCache;
+use std::fs;
+use std::io::{self, Read, Write};
+use std::path::Path;
+
+const CELL_DATA_CACHE_MAGIC: &[u8; 8] = b"ckbcelld";
+const CELL_DATA_CACHE_VERSION: u32 = 1;
+// cell keys are out-point based and small; data entries may be whole dep
+// cells (the secp data cell is ~1MB), cap them defensively when loading
+const CELL_DATA_CACHE_MAX_KEY_LEN: usize = 64;
+const CELL_DATA_CACHE_MAX_DATA_LEN: usize = 32 * 1024 * 1024;
 
 /// TODO(doc): @quake
 pub struct StoreCache {
@@ -44,4 +55,95 @@ impl StoreCache {
             block_extensions: Mutex::new(LruCache::new(config.block_extensions_cache_size)),
         }
     }
+
+    /// Dumps the cell data cache to `path` in hot-first order, so a later
+    /// [`warm_cell_data`](#method.warm_cell_data) restores the access
+    /// frequency of this run. The file is written atomically.
+    pub fn dump_cell_data<P: AsRef<Path>>(&self, path: P) -> io::Result<()> {
+        let tmp_path = path.as_ref().with_extension("tmp");
+        {
+            let mut file = io::BufWriter::new(fs::File::create(&tmp_path)?);
+            file.write_all(CELL_DATA_CACHE_MAGIC)?;
+            file.write_all(&CELL_DATA_CACHE_VERSION.to_le_bytes())?;
+            let guard = self.cell_data.lock();
+            for (key, (data, data_hash)) in guard.iter() {
+                file.write_all(&(key.len() as u32).to_le_bytes())?;
+                file.write_all(key)?;
+                file.write_all(&(data.len() as u32).to_le_bytes())?;
+                file.write_all(data)?;
+                file.write_all(data_hash.as_slice())?;
+            }
+            file.flush()?;
+        }
+        fs::rename(&tmp_path, path)
+    }
+
+    /// Warms the cell data caches from a previous run's dump, returning the
+    /// number of restored entries. Every record's data hash is recomputed, so
+    /// a corrupt file is rejected instead of poisoning the cache.
+    pub fn warm_cell_data<P: AsRef<Path>>(&self, path: P) -> io::Result<usize> {
+        let mut file = io::BufReader::new(fs::File::open(path)?);
+        let mut magic = [0u8; 8];
+        file.read_exact(&mut magic)?;
+        let mut version = [0u8; 4];
+        file.read_exact(&mut version)?;
+        if &magic != CELL_DATA_CACHE_MAGIC || u32::from_le_bytes(version) != CELL_DATA_CACHE_VERSION
+        {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                "cell data cache version mismatch",
+            ));
+        }
+
+        let mut entries = Vec::new();
+        loop {
+            let mut len_buf = [0u8; 4];
+            match file.read_exact(&mut len_buf) {
+                Ok(()) => {}
+                Err(err) if err.kind() == io::ErrorKind::UnexpectedEof => break,
+                Err(err) => return Err(err),
+            }
+            let key_len = u32::from_le_bytes(len_buf) as usize;
+            if key_len > CELL_DATA_CACHE_MAX_KEY_LEN {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidData,
+                    "cell data cache key too long",
+                ));
+            }
+            let mut key = vec![0u8; key_len];
+            file.read_exact(&mut key)?;
+            file.read_exact(&mut len_buf)?;
+            let data_len = u32::from_le_bytes(len_buf) as usize;
+            if data_len > CELL_DATA_CACHE_MAX_DATA_LEN {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidData,
+                    "cell data cache entry too large",
+                ));
+            }
+            let mut data = vec![0u8; data_len];
+            file.read_exact(&mut data)?;
+            let mut hash = [0u8; 32];
+            file.read_exact(&mut hash)?;
+            let data = Bytes::from(data);
+            let data_hash = CellOutput::calc_data_hash(&data);
+            if data_hash.as_slice() != hash {
+                return Err(io::Error::new(
+                    io::ErrorKind::InvalidData,
+                    "cell data cache checksum mismatch",
+                ));
+            }
+            entries.push((key, data, data_hash));
+        }
+
+        let count = entries.len();
+        let mut cell_data = self.cell_data.lock();
+        let mut cell_data_hash = self.cell_data_hash.lock();
+        // records are hot-first, insert in reverse so the hottest entries end
+        // up most recently used
+        for (key, data, data_hash) in entries.into_iter().rev() {
+            cell_data.put(key.clone(), (data, data_hash.clone()));
+            cell_data_hash.put(key, data_hash);
+        }
+        Ok(count)
+    }
 }
@@ -1,6 +1,7 @@
 use crate::{ChainStore, StoreTransaction};
 use ckb_error::Error;
 use ckb_types::{core::BlockView, packed, prelude::*};
+use rayon::prelude::*;
 use std::collections::HashMap;
 
 /**
@@ -26,11 +27,13 @@ use std::collections::HashMap;
 pub fn attach_block_cell(txn: &StoreTransaction, block: &BlockView) -> Result<(), Error> {
     let transactions = block.transactions();
 
-    // add new live cells
-    let new_cells = transactions
-        .iter()
+    // add new live cells; entry serialization (molecule building and cell
+    // data hashing) is independent per transaction, so it runs across the
+    // rayon pool before the sequential transaction writes
+    let new_cells: Vec<_> = transactions
+        .par_iter()
         .enumerate()
-        .map(move |(tx_index, tx)| {
+        .map(|(tx_index, tx)| {
             let tx_hash = tx.hash();
             let block_hash = block.header().hash();
             let block_number = block.header().number();
@@ -38,7 +41,7 @@ pub fn attach_block_cell(txn: &StoreTransaction, block: &BlockView) -> Result<()
 
             tx.outputs_with_data_iter()
                 .enumerate()
-                .map(move |(index, (cell_output, data))| {
+                .map(|(index, (cell_output, data))| {
                     let out_point = packed::OutPoint::new_builder()
                         .tx_hash(tx_hash.clone())
                         .index(index.pack())
@@ -67,9 +70,11 @@ pub fn attach_block_cell(txn: &StoreTransaction, block: &BlockView) -> Result<()
 
                     (out_point, entry, data_entry)
                 })
+                .collect::<Vec<_>>()
         })
-        .flatten();
-    txn.insert_cells(new_cells)?;
+        .flatten()
+        .collect();
+    txn.insert_cells(new_cells.into_iter())?;
 
     // mark inputs dead
     // skip cellbase
@@ -13,7 +13,9 @@ use ckb_db::{
 use ckb_db_schema::{Col, CHAIN_SPEC_HASH_KEY, MIGRATION_VERSION_KEY};
 use ckb_error::Error;
 use ckb_freezer::Freezer;
+use ckb_logger::{info, warn};
 use ckb_types::{core::BlockExt, packed, prelude::*};
+use std::path::PathBuf;
 use std::sync::Arc;
 
 /// TODO(doc): @quake
@@ -22,6 +24,7 @@ pub struct ChainDB {
     db: RocksDB,
     freezer: Option<Freezer>,
     cache: Arc<StoreCache>,
+    cell_data_cache_file: Option<PathBuf>,
 }
 
 impl<'a> ChainStore<'a> for ChainDB {
@@ -54,6 +57,7 @@ impl ChainDB {
             db,
             freezer: None,
             cache: Arc::new(cache),
+            cell_data_cache_file: None,
         }
     }
 
@@ -64,6 +68,38 @@ impl ChainDB {
             db,
             freezer: Some(freezer),
             cache: Arc::new(cache),
+            cell_data_cache_file: None,
+        }
+    }
+
+    /// Attaches a persistent cell data cache file: warms the in-memory cache
+    /// from the previous run's dump right away and remembers the path so
+    /// `dump_cell_data_cache` can persist this run's hot entries at shutdown.
+    pub fn with_cell_data_cache_file(mut self, path: PathBuf) -> Self {
+        match self.cache.warm_cell_data(&path) {
+            Ok(count) => info!("warmed {} cell data entries from {}", count, path.display()),
+            Err(err) if err.kind() == std::io::ErrorKind::NotFound => (),
+            Err(err) => warn!(
+                "failed to warm cell data cache from {}: {}",
+                path.display(),
+                err
+            ),
+        }
+        self.cell_data_cache_file = Some(path);
+        self
+    }
+
+    /// Persists the hot cell data entries for the next run, best-effort.
+    pub fn dump_cell_data_cache(&self) {
+        if let Some(ref path) = self.cell_data_cache_file {
+            match self.cache.dump_cell_data(path) {
+                Ok(()) => info!("dumped cell data cache to {}", path.display()),
+                Err(err) => warn!(
+                    "failed to dump cell data cache to {}: {}",
+                    path.display(),
+                    err
+                ),
+            }
         }
     }
 
@@ -71,6 +71,45 @@ pub trait ChainStore<'a>: Send + Sync + Sized {
         Some(block)
     }
 
+    /// Get up to `count` consecutive main-chain blocks starting at `start`.
+    ///
+    /// Frozen blocks are fetched through the freezer's batch retrieval, one
+    /// contiguous data read per file segment instead of a point read per
+    /// block; the warm remainder falls back to per-number lookups. Returns
+    /// fewer blocks when the range runs past the tip or a block is missing.
+    fn get_blocks_in_range(&'a self, start: BlockNumber, count: u64) -> Vec<BlockView> {
+        let end = start.saturating_add(count);
+        let mut blocks = Vec::with_capacity(count as usize);
+        let mut number = start;
+
+        if let Some(freezer) = self.freezer() {
+            if number > 0 && number < freezer.number() {
+                let frozen = freezer
+                    .retrieve_batch(number, end - number)
+                    .expect("blocks frozen");
+                for raw_block in frozen {
+                    let raw_block = packed::BlockReader::from_compatible_slice(&raw_block)
+                        .expect("checked data")
+                        .to_entity();
+                    blocks.push(raw_block.into_view());
+                    number += 1;
+                }
+            }
+        }
+
+        while number < end {
+            let block = self
+                .get_block_hash(number)
+                .and_then(|block_hash| self.get_block(&block_hash));
+            match block {
+                Some(block) => blocks.push(block),
+                None => break,
+            }
+            number += 1;
+        }
+        blocks
+    }
+
     /// Get header by block header hash
     fn get_block_header(&'a self, hash: &packed::Byte32) -> Option<HeaderView> {
         if let Some(cache) = self.cache() {
@@ -1,36 +1,98 @@
-use ckb_types::{core, packed};
-use ckb_util::shrink_to_fit;
+use ckb_types::{core, packed, prelude::*};
+use ckb_util::{shrink_to_fit, Mutex};
 use dashmap::DashMap;
 use std::collections::{HashMap, VecDeque};
 
 pub type ParentHash = packed::Byte32;
 const SHRINK_THRESHOLD: usize = 100;
 
+/// Default memory ceiling for the serialized blocks held by the pool.
+/// Orphans over budget are evicted oldest-first; the caller clears their
+/// block status so the normal download path re-requests them once their
+/// parent arrives.
+const DEFAULT_MAX_POOL_BYTES: usize = 256 << 20;
+
 // NOTE: Never use `LruCache` as container. We have to ensure synchronizing between
 // orphan_block_pool and block_status_map, but `LruCache` would prune old items implicitly.
-#[derive(Default)]
+// Eviction here is explicit instead: `insert` returns the evicted hashes so the
+// caller can keep the block status map in sync.
 pub struct OrphanBlockPool {
-    blocks: DashMap<ParentHash, HashMap<packed::Byte32, core::BlockView>>,
+    // blocks are kept in compact serialized form; the unpacked view with its
+    // cached hashes is rebuilt only when a block leaves the pool
+    blocks: DashMap<ParentHash, HashMap<packed::Byte32, packed::Block>>,
     parents: DashMap<packed::Byte32, ParentHash>,
+    accounting: Mutex<Accounting>,
+    max_bytes: usize,
+}
+
+#[derive(Default)]
+struct Accounting {
+    // insertion order, lazily pruned: hashes already removed through
+    // `remove_blocks_by_parent` are skipped when they surface
+    queue: VecDeque<packed::Byte32>,
+    total_bytes: usize,
 }
 
 impl OrphanBlockPool {
     pub fn with_capacity(capacity: usize) -> Self {
+        Self::with_byte_budget(capacity, DEFAULT_MAX_POOL_BYTES)
+    }
+
+    /// Creates a pool with an explicit serialized-size budget.
+    pub fn with_byte_budget(capacity: usize, max_bytes: usize) -> Self {
         OrphanBlockPool {
             blocks: DashMap::with_capacity(capacity),
             parents: DashMap::new(),
+            accounting: Mutex::new(Accounting::default()),
+            max_bytes,
         }
     }
 
-    /// Insert orphaned block, for which we have already requested its parent block
-    pub fn insert(&self, block: core::BlockView) {
+    /// Insert orphaned block, for which we have already requested its parent block.
+    ///
+    /// Returns the hashes of blocks evicted to keep the pool under its byte
+    /// budget; the caller must drop their block status so they are requested
+    /// again later.
+    pub fn insert(&self, block: core::BlockView) -> Vec<packed::Byte32> {
         let hash = block.header().hash();
         let parent_hash = block.data().header().raw().parent_hash();
-        self.blocks
+        let data = block.data();
+        let data_size = data.as_slice().len();
+        let replaced = self
+            .blocks
             .entry(parent_hash.clone())
             .or_insert_with(HashMap::default)
-            .insert(hash.clone(), block);
-        self.parents.insert(hash, parent_hash);
+            .insert(hash.clone(), data)
+            .is_some();
+        self.parents.insert(hash.clone(), parent_hash);
+
+        let mut guard = self.accounting.lock();
+        // a re-inserted orphan is already queued and accounted; counting it
+        // again would leak budget, its stale queue entry is skipped at
+        // eviction without a subtraction
+        if !replaced {
+            guard.queue.push_back(hash);
+            guard.total_bytes += data_size;
+        }
+
+        let mut evicted = Vec::new();
+        while guard.total_bytes > self.max_bytes && guard.queue.len() > 1 {
+            let old_hash = guard.queue.pop_front().expect("checked non-empty");
+            let parent_hash = match self.parents.remove(&old_hash) {
+                Some((_, parent_hash)) => parent_hash,
+                // already drained through remove_blocks_by_parent
+                None => continue,
+            };
+            if let Some(mut entry) = self.blocks.get_mut(&parent_hash) {
+                if let Some(data) = entry.remove(&old_hash) {
+                    guard.total_bytes = guard
+                        .total_bytes
+                        .saturating_sub(data.as_slice().len());
+                }
+            }
+            evicted.push(old_hash);
+        }
+        evicted
     }
 
     pub fn remove_blocks_by_parent(&self, hash: &packed::Byte32) -> Vec<core::BlockView> {
@@ -38,6 +100,7 @@ impl OrphanBlockPool {
         queue.push_back(hash.to_owned());
 
         let mut removed: Vec<core::BlockView> = Vec::new();
+        let mut removed_bytes = 0usize;
         while let Some(parent_hash) = queue.pop_front() {
             if let Some((_, orphaned)) = self.blocks.remove(&parent_hash) {
                 let (hashes, blocks): (Vec<_>, Vec<_>) = orphaned.into_iter().unzip();
@@ -45,10 +108,18 @@ impl OrphanBlockPool {
                     self.parents.remove(hash);
                 }
                 queue.extend(hashes);
-                removed.extend(blocks);
+                removed_bytes += blocks
+                    .iter()
+                    .map(|data| data.as_slice().len())
+                    .sum::<usize>();
+                removed.extend(blocks.into_iter().map(packed::Block::into_view));
             }
         }
 
+        let mut guard = self.accounting.lock();
+        guard.total_bytes = guard.total_bytes.saturating_sub(removed_bytes);
+        drop(guard);
+
         shrink_to_fit!(self.blocks, SHRINK_THRESHOLD);
         shrink_to_fit!(self.parents, SHRINK_THRESHOLD);
         removed
@@ -58,13 +129,18 @@ impl OrphanBlockPool {
         self.parents.get(hash).and_then(|parent_hash| {
             self.blocks
                 .get(&parent_hash)
-                .and_then(|blocks| blocks.get(hash).cloned())
+                .and_then(|blocks| blocks.get(hash).cloned().map(packed::Block::into_view))
         })
     }
 
     pub fn len(&self) -> usize {
         self.parents.len()
     }
+
+    /// Total size of the serialized blocks currently held.
+    pub fn total_bytes(&self) -> usize {
+        self.accounting.lock().total_bytes
+    }
 }
 
 #[cfg(test)]
@@ -100,11 +176,13 @@ mod tests {
             pool.insert(new_block.clone());
             parent = new_block.header();
         }
+        assert!(pool.total_bytes() > 0);
 
         let orphan = pool.remove_blocks_by_parent(&consensus.genesis_block().hash());
         let orphan: HashSet<BlockView> = orphan.into_iter().collect();
         let block: HashSet<BlockView> = blocks.into_iter().collect();
-        assert_eq!(orphan, block)
+        assert_eq!(orphan, block);
+        assert_eq!(pool.total_bytes(), 0);
     }
 
     #[test]
@@ -133,4 +211,54 @@ mod tests {
 
         thread1.join().unwrap();
     }
+
+    #[test]
+    fn test_byte_budget_eviction() {
+        let consensus = ConsensusBuilder::default().build();
+        let mut parent = consensus.genesis_block().header();
+        let mut blocks = Vec::new();
+        for _ in 0..4 {
+            let new_block = gen_block(&parent);
+            parent = new_block.header();
+            blocks.push(new_block);
+        }
+        let block_size = blocks[0].data().as_slice().len();
+
+        // room for two blocks, the third insert must evict the oldest
+        let pool = OrphanBlockPool::with_byte_budget(16, block_size * 2);
+        assert!(pool.insert(blocks[0].clone()).is_empty());
+        assert!(pool.insert(blocks[1].clone()).is_empty());
+
+        let evicted = pool.insert(blocks[2].clone());
+        assert_eq!(evicted, vec![blocks[0].hash()]);
+        assert!(pool.get_block(&blocks[0].hash()).is_none());
+
+        // eviction is oldest-first across inserts
+        let evicted = pool.insert(blocks[3].clone());
+        assert_eq!(evicted, vec![blocks[1].hash()]);
+
+        assert_eq!(pool.len(), 2);
+        assert_eq!(pool.total_bytes(), block_size * 2);
+        assert!(pool.get_block(&blocks[2].hash()).is_some());
+        assert!(pool.get_block(&blocks[3].hash()).is_some());
+    }
+
+    #[test]
+    fn test_duplicate_insert_accounting() {
+        let consensus = ConsensusBuilder::default().build();
+        let block = gen_block(&consensus.genesis_block().header());
+        let block_size = block.data().as_slice().len();
+
+        let pool = OrphanBlockPool::with_byte_budget(16, block_size * 2);
+        assert!(pool.insert(block.clone()).is_empty());
+        // a racing re-insert of the same orphan must not be accounted twice
+        assert!(pool.insert(block.clone()).is_empty());
+        assert_eq!(pool.len(), 1);
+        assert_eq!(pool.total_bytes(), block_size);
+
+        let removed = pool.remove_blocks_by_parent(&consensus.genesis_block().hash());
+        assert_eq!(removed.len(), 1);
+        assert_eq!(pool.total_bytes(), 0);
+    }
 }
+
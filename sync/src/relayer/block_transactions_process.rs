@@ -1,7 +1,7 @@
 use crate::relayer::block_transactions_verifier::BlockTransactionsVerifier;
 use crate::relayer::block_uncles_verifier::BlockUnclesVerifier;
 use crate::relayer::{ReconstructionResult, Relayer};
-use crate::utils::send_message_to;
+use crate::utils::quick_send_message_to;
 use crate::{attempt, Status, StatusCode};
 use ckb_network::{CKBProtocolContext, PeerIndex};
 use ckb_types::{core, packed, prelude::*};
@@ -156,7 +156,7 @@ impl<'a> BlockTransactionsProcess<'a> {
                         .build();
                     let message = packed::RelayMessage::new_builder().set(content).build();
 
-                    attempt!(send_message_to(self.nc.as_ref(), self.peer, &message));
+                    attempt!(quick_send_message_to(self.nc.as_ref(), self.peer, &message));
                 }
 
                 let _ignore_prev_value =
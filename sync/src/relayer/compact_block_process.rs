@@ -1,9 +1,10 @@
 use crate::block_status::BlockStatus;
 use crate::relayer::compact_block_verifier::CompactBlockVerifier;
 use crate::relayer::{ReconstructionResult, Relayer};
-use crate::utils::send_message_to;
+use crate::utils::quick_send_message_to;
 use crate::{attempt, Status, StatusCode};
 use ckb_logger::{self, debug_target};
+use ckb_metrics::{metrics, Timer};
 use ckb_network::{CKBProtocolContext, PeerIndex};
 use ckb_traits::HeaderProvider;
 use ckb_types::{core, packed, prelude::*};
@@ -43,6 +44,7 @@ impl<'a> CompactBlockProcess<'a> {
     }
 
     pub fn execute(self) -> Status {
+        let timer = Timer::start();
         let shared = self.relayer.shared();
         {
             let compact_block = self.message;
@@ -207,6 +209,9 @@ impl<'a> CompactBlockProcess<'a> {
                     pending_compact_blocks.remove(&block_hash);
                     self.relayer
                         .accept_block(self.nc.as_ref(), self.peer, block);
+                    // time from receiving the announcement to the block
+                    // entering the chain, the propagation-critical span
+                    metrics!(timing, "ckb.compact_block_accepted", timer.stop());
                     return Status::ok();
                 }
                 ReconstructionResult::Missing(transactions, uncles) => {
@@ -262,7 +267,7 @@ impl<'a> CompactBlockProcess<'a> {
             .uncle_indexes(missing_uncles.pack())
             .build();
         let message = packed::RelayMessage::new_builder().set(content).build();
-        let sending = send_message_to(self.nc.as_ref(), self.peer, &message);
+        let sending = quick_send_message_to(self.nc.as_ref(), self.peer, &message);
         if !sending.is_ok() {
             ckb_logger::warn_target!(
                 crate::LOG_TARGET_RELAY,
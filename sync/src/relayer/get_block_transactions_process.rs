@@ -1,5 +1,5 @@
 use crate::relayer::{Relayer, MAX_RELAY_TXS_NUM_PER_BATCH};
-use crate::utils::send_message_to;
+use crate::utils::quick_send_message_to;
 use crate::{attempt, Status, StatusCode};
 use ckb_logger::debug_target;
 use ckb_network::{CKBProtocolContext, PeerIndex};
@@ -84,7 +84,7 @@ impl<'a> GetBlockTransactionsProcess<'a> {
                 .build();
             let message = packed::RelayMessage::new_builder().set(content).build();
 
-            attempt!(send_message_to(self.nc.as_ref(), self.peer, &message));
+            attempt!(quick_send_message_to(self.nc.as_ref(), self.peer, &message));
         }
 
         Status::ok()
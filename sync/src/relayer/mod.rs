@@ -386,11 +386,23 @@ impl Relayer {
         if !short_ids_set.is_empty() {
             let tx_pool = self.shared.shared().tx_pool_controller();
 
-            let fetch_txs = tx_pool.fetch_txs(short_ids_set.into_iter().collect());
-            if let Err(e) = fetch_txs {
-                return ReconstructionResult::Error(StatusCode::TxPool.with_context(e));
+            // common case: every missing tx is in the pool's short-id index,
+            // resolved in one synchronous pass without a service round trip
+            let fetched = tx_pool.fetch_txs_sync(short_ids_set.iter().cloned());
+            for short_id in fetched.keys() {
+                short_ids_set.remove(short_id);
+            }
+            txs_map.extend(fetched.into_iter());
+
+            // the index does not cover recently-committed txs, ask the
+            // service for any leftovers before requesting them from the peer
+            if !short_ids_set.is_empty() {
+                let fetch_txs = tx_pool.fetch_txs(short_ids_set.into_iter().collect());
+                if let Err(e) = fetch_txs {
+                    return ReconstructionResult::Error(StatusCode::TxPool.with_context(e));
+                }
+                txs_map.extend(fetch_txs.unwrap().into_iter());
             }
-            txs_map.extend(fetch_txs.unwrap().into_iter());
         }
 
         let txs_len = compact_block.txs_len();
@@ -185,10 +185,30 @@ impl<'a> BlockFetcher<'a> {
             )
         }
 
+        let mut fetch_hashes: Vec<packed::Byte32> =
+            fetch.iter().map(core::HeaderView::hash).collect();
+
+        // When the download window is saturated by other peers but this peer
+        // still has spare capacity, speculatively re-request the slowest tail
+        // blocks from it instead of idling. The capacity already accounts
+        // for the blocks registered in-flight above.
+        if let IBDState::In = self.ibd {
+            let can_fetch = inflight.peer_can_fetch_count(self.peer);
+            if can_fetch > 0 {
+                for block in inflight.steal_tail_blocks(self.peer, tip, can_fetch) {
+                    debug!(
+                        "[block_fetcher] steal tail block {}-{} for peer {}",
+                        block.number, block.hash, self.peer
+                    );
+                    fetch_hashes.push(block.hash);
+                }
+            }
+        }
+
         Some(
-            fetch
+            fetch_hashes
                 .chunks(INIT_BLOCKS_IN_TRANSIT_PER_PEER)
-                .map(|headers| headers.iter().map(core::HeaderView::hash).collect())
+                .map(|hashes| hashes.to_vec())
                 .collect(),
         )
     }
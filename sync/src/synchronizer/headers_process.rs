@@ -125,6 +125,14 @@ impl<'a> HeadersProcess<'a> {
             return StatusCode::HeadersIsInvalid.with_context("not continuous");
         }
 
+        // PoW evaluation dominates header verification and is independent
+        // per header, so the whole batch is hashed across the rayon pool
+        // before the sequential per-header acceptance below
+        if let Err(error) = HeaderVerifier::new(shared, consensus).verify_pow_batch(&headers) {
+            debug!("HeadersProcess pow batch verify error {:?}", error);
+            return StatusCode::HeadersIsInvalid.with_context("invalid PoW");
+        }
+
         let result = self.accept_first(&headers[0]);
         match result.state {
             ValidationState::Invalid => {
@@ -242,7 +250,9 @@ impl<'a, DL: HeaderProvider> HeaderAcceptor<'a, DL> {
     }
 
     pub fn non_contextual_check(&self, state: &mut ValidationResult) -> Result<(), bool> {
-        self.verifier.verify(self.header).map_err(|error| {
+        // the whole message's PoW was batch-verified in HeadersProcess
+        // before any acceptor runs
+        self.verifier.verify_pow_checked(self.header).map_err(|error| {
             debug!(
                 "HeadersProcess accept {:?} error {:?}",
                 self.header.number(),
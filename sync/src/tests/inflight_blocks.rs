@@ -27,7 +27,7 @@ fn inflight_blocks_count() {
     );
 
     // receive block 0x1
-    inflight_blocks.remove_by_block((1, h256!("0x1").pack()).into());
+    inflight_blocks.remove_by_block((1, h256!("0x1").pack()).into(), 0);
 
     assert_eq!(inflight_blocks.total_inflight_count(), 1); // 0x2
     assert_eq!(inflight_blocks.peer_inflight_count(1.into()), 1);
@@ -198,3 +198,73 @@ fn inflight_trace_number_state() {
     assert_eq!(inflight_blocks.peer_can_fetch_count(3.into()), 8);
     assert_eq!(inflight_blocks.peer_can_fetch_count(4.into()), 8);
 }
+
+#[cfg(not(disable_faketime))]
+#[test]
+fn inflight_blocks_steal_tail() {
+    let faketime_file = faketime::millis_tempfile(0).expect("create faketime file");
+    faketime::enable(&faketime_file);
+    let mut inflight_blocks = InflightBlocks::default();
+
+    // seed throughput: peer 1 completes a large block quickly, peer 2 a tiny
+    // one, so peer 1 measures as the faster downloader
+    assert!(inflight_blocks.insert(1.into(), (1, h256!("0x1").pack()).into()));
+    assert!(inflight_blocks.insert(2.into(), (2, h256!("0x2").pack()).into()));
+    faketime::write_millis(&faketime_file, 1000).expect("write millis");
+    assert!(inflight_blocks.remove_by_block((1, h256!("0x1").pack()).into(), 1_000_000));
+    assert!(inflight_blocks.remove_by_block((2, h256!("0x2").pack()).into(), 1_000));
+
+    // the slow peer holds two tail blocks near the tip, one far beyond the
+    // steal window, and (later) one requested too recently to steal
+    assert!(inflight_blocks.insert(2.into(), (3, h256!("0x3").pack()).into()));
+    assert!(inflight_blocks.insert(2.into(), (4, h256!("0x4").pack()).into()));
+    assert!(inflight_blocks.insert(2.into(), (100, h256!("0x64").pack()).into()));
+    faketime::write_millis(&faketime_file, 1000 + BLOCK_DOWNLOAD_TIMEOUT / 2 + 1)
+        .expect("write millis");
+    assert!(inflight_blocks.insert(2.into(), (5, h256!("0x5").pack()).into()));
+
+    // a peer without any throughput measurement steals nothing
+    assert!(inflight_blocks
+        .steal_tail_blocks(9.into(), 3, 10)
+        .is_empty());
+
+    // `max` caps how much is reassigned per call
+    let stolen = inflight_blocks.steal_tail_blocks(1.into(), 3, 1);
+    assert_eq!(stolen, vec![(3, h256!("0x3").pack()).into()]);
+
+    let stolen = inflight_blocks.steal_tail_blocks(1.into(), 3, 10);
+    // block 5 is too fresh, block 100 is beyond the tail window
+    assert_eq!(stolen, vec![(4, h256!("0x4").pack()).into()]);
+
+    // reassignment bookkeeping: states moved to peer 1, hash sets updated on
+    // both sides, nothing lost
+    let reassigned: Vec<BlockNumberAndHash> = vec![
+        (3, h256!("0x3").pack()).into(),
+        (4, h256!("0x4").pack()).into(),
+    ];
+    for block in reassigned {
+        assert_eq!(
+            inflight_blocks
+                .inflight_state_by_block(&block)
+                .map(|state| state.peer),
+            Some(1.into())
+        );
+        assert!(inflight_blocks
+            .inflight_block_by_peer(1.into())
+            .map_or(false, |set| set.contains(&block)));
+        assert!(inflight_blocks
+            .inflight_block_by_peer(2.into())
+            .map_or(true, |set| !set.contains(&block)));
+    }
+    assert_eq!(inflight_blocks.total_inflight_count(), 4);
+    assert_eq!(inflight_blocks.peer_inflight_count(1.into()), 2);
+    assert_eq!(inflight_blocks.peer_inflight_count(2.into()), 2);
+
+    // throughput gating: a slower peer must not steal from a faster one,
+    // even once the faster peer's requests go stale
+    faketime::write_millis(&faketime_file, 1000 + BLOCK_DOWNLOAD_TIMEOUT + 2)
+        .expect("write millis");
+    assert!(inflight_blocks
+        .steal_tail_blocks(2.into(), 3, 10)
+        .is_empty());
+}
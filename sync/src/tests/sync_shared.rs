@@ -204,3 +204,38 @@ fn test_switch_valid_fork() {
         );
     }
 }
+
+#[test]
+fn test_take_relay_tx_hashes_orders_by_fee_rate() {
+    let (shared, _pack) = SharedBuilder::with_temp_db().build().unwrap();
+    // drive the announcement queue through our own channel
+    let (sender, receiver) = ckb_channel::unbounded();
+    let sync_shared = SyncShared::new(shared, Default::default(), receiver);
+    let state = sync_shared.state();
+
+    let hash = |i: u8| ckb_types::packed::Byte32::from_slice(&[i; 32]).unwrap();
+    let fee = ckb_types::core::FeeRate::from_u64;
+    for (i, rate) in &[(1u8, 10u64), (2, 30), (3, 10), (4, 20)] {
+        sender.send((None, true, hash(*i), fee(*rate))).unwrap();
+    }
+
+    // highest fee rate first, arrival order among ties, limit respected
+    let taken: Vec<_> = state
+        .take_relay_tx_hashes(3)
+        .into_iter()
+        .map(|(_, _, hash)| hash)
+        .collect();
+    assert_eq!(taken, vec![hash(2), hash(4), hash(1)]);
+
+    // the leftover low-fee announcement stays queued and keeps its arrival
+    // order against later arrivals of the same rate
+    sender.send((None, true, hash(5), fee(10))).unwrap();
+    sender.send((None, true, hash(6), fee(20))).unwrap();
+    let taken: Vec<_> = state
+        .take_relay_tx_hashes(10)
+        .into_iter()
+        .map(|(_, _, hash)| hash)
+        .collect();
+    assert_eq!(taken, vec![hash(6), hash(3), hash(5)]);
+    assert!(state.take_relay_tx_hashes(10).is_empty());
+}
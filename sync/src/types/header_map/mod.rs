@@ -1,6 +1,6 @@
 use std::path;
 
-use ckb_types::packed::Byte32;
+use ckb_types::{packed::Byte32, prelude::*};
 use ckb_util::Mutex;
 
 use crate::types::HeaderView;
@@ -15,7 +15,15 @@ pub(crate) use self::{
     memory::KeyValueMemory,
 };
 
-pub struct HeaderMapLru(Mutex<HeaderMapLruKernel<RocksDBBackend>>);
+// must be a power of two
+const SHARD_COUNT: usize = 16;
+
+/// Header map sharded by hash prefix, each shard a separate lru kernel
+/// behind its own lock, so headers-sync bursts inserting thousands of
+/// headers do not serialize against the reader paths walking ancestors.
+pub struct HeaderMapLru {
+    shards: Vec<Mutex<HeaderMapLruKernel<RocksDBBackend>>>,
+}
 
 impl HeaderMapLru {
     pub(crate) fn new<P>(
@@ -26,23 +34,36 @@ impl HeaderMapLru {
     where
         P: AsRef<path::Path>,
     {
-        let inner = HeaderMapLruKernel::new(tmpdir, primary_limit, backend_close_threshold);
-        Self(Mutex::new(inner))
+        let shards = (0..SHARD_COUNT)
+            .map(|_| {
+                Mutex::new(HeaderMapLruKernel::new(
+                    tmpdir.as_ref(),
+                    primary_limit / SHARD_COUNT,
+                    backend_close_threshold / SHARD_COUNT,
+                ))
+            })
+            .collect();
+        Self { shards }
+    }
+
+    fn shard(&self, hash: &Byte32) -> &Mutex<HeaderMapLruKernel<RocksDBBackend>> {
+        let prefix = hash.as_slice()[0] as usize;
+        &self.shards[prefix & (SHARD_COUNT - 1)]
     }
 
     pub(crate) fn contains_key(&self, hash: &Byte32) -> bool {
-        self.0.lock().contains_key(hash)
+        self.shard(hash).lock().contains_key(hash)
     }
 
     pub(crate) fn get(&self, hash: &Byte32) -> Option<HeaderView> {
-        self.0.lock().get(hash)
+        self.shard(hash).lock().get(hash)
     }
 
     pub(crate) fn insert(&self, view: HeaderView) -> Option<HeaderView> {
-        self.0.lock().insert(view)
+        self.shard(&view.hash()).lock().insert(view)
     }
 
     pub(crate) fn remove(&self, hash: &Byte32) -> Option<HeaderView> {
-        self.0.lock().remove(hash)
+        self.shard(hash).lock().remove(hash)
     }
 }
@@ -20,7 +20,7 @@ use ckb_shared::{shared::Shared, Snapshot};
 use ckb_store::{ChainDB, ChainStore};
 use ckb_traits::HeaderProvider;
 use ckb_types::{
-    core::{self, BlockNumber, EpochExt},
+    core::{self, BlockNumber, EpochExt, FeeRate},
     packed::{self, Byte32},
     prelude::*,
     H256, U256,
@@ -31,10 +31,10 @@ use dashmap::{DashMap, DashSet};
 use faketime::unix_time_as_millis;
 use keyed_priority_queue::{self, KeyedPriorityQueue};
 use lru::LruCache;
-use std::collections::{btree_map::Entry, BTreeMap, HashMap, HashSet};
+use std::collections::{btree_map::Entry, BTreeMap, BinaryHeap, HashMap, HashSet};
 use std::hash::Hash;
 use std::path::{Path, PathBuf};
-use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
 use std::sync::Arc;
 use std::time::{Duration, Instant};
 use std::{cmp, fmt, iter};
@@ -468,6 +468,9 @@ impl TimeAnalyzer {
 pub struct DownloadScheduler {
     task_count: usize,
     timeout_count: usize,
+    // EWMA of this peer's measured download throughput in bytes per second,
+    // zero until the first block arrives
+    ewma_throughput: u64,
     hashes: HashSet<BlockNumberAndHash>,
 }
 
@@ -477,6 +480,7 @@ impl Default for DownloadScheduler {
             hashes: HashSet::default(),
             task_count: INIT_BLOCKS_IN_TRANSIT_PER_PEER,
             timeout_count: 0,
+            ewma_throughput: 0,
         }
     }
 }
@@ -514,6 +518,21 @@ impl DownloadScheduler {
     fn punish(&mut self, exp: usize) {
         self.task_count >>= exp
     }
+
+    // alpha = 1/4: enough history to smooth bursts while tracking peer
+    // speed changes within a few responses
+    fn sample_throughput(&mut self, bytes: u64, elapsed_ms: u64) {
+        let sample = bytes.saturating_mul(1000) / ::std::cmp::max(elapsed_ms, 1);
+        if self.ewma_throughput == 0 {
+            self.ewma_throughput = sample;
+        } else {
+            self.ewma_throughput = (self.ewma_throughput / 4).saturating_mul(3) + sample / 4;
+        }
+    }
+
+    pub(crate) const fn throughput(&self) -> u64 {
+        self.ewma_throughput
+    }
 }
 
 #[derive(Clone)]
@@ -794,8 +813,24 @@ impl InflightBlocks {
             .is_some()
     }
 
-    pub fn remove_by_block(&mut self, block: BlockNumberAndHash) -> bool {
+    pub fn remove_by_block(&mut self, block: BlockNumberAndHash, size: u64) -> bool {
         let should_punish = self.download_schedulers.len() > self.protect_num;
+        // mean throughput over peers with at least one measurement, used to
+        // grow the stripes of measurably fast peers beyond what the latency
+        // quantiles alone would give and to shrink persistent laggards
+        let mean_throughput = {
+            let measured: Vec<u64> = self
+                .download_schedulers
+                .values()
+                .map(DownloadScheduler::throughput)
+                .filter(|t| *t > 0)
+                .collect();
+            if measured.is_empty() {
+                0
+            } else {
+                measured.iter().sum::<u64>() / measured.len() as u64
+            }
+        };
         let download_schedulers = &mut self.download_schedulers;
         let trace = &mut self.trace_number;
         let compact = &mut self.compact_reconstruct_inflight;
@@ -807,6 +842,9 @@ impl InflightBlocks {
                 let elapsed = unix_time_as_millis().saturating_sub(state.timestamp);
                 if let Some(set) = download_schedulers.get_mut(&state.peer) {
                     set.hashes.remove(&block);
+                    if size > 0 {
+                        set.sample_throughput(size, elapsed);
+                    }
                     if !compact.is_empty() {
                         compact.remove(&block.hash);
                     }
@@ -825,6 +863,17 @@ impl InflightBlocks {
                                 }
                             }
                         }
+                        if mean_throughput > 0 {
+                            let throughput = set.throughput();
+                            if throughput > mean_throughput.saturating_mul(2) {
+                                set.increase(1)
+                            } else if should_punish
+                                && throughput > 0
+                                && throughput.saturating_mul(2) < mean_throughput
+                            {
+                                set.decrease(1)
+                            }
+                        }
                     }
                     if !trace.is_empty() {
                         trace.remove(&block);
@@ -833,6 +882,66 @@ impl InflightBlocks {
             })
             .is_some()
     }
+
+    /// Re-requests the slowest tail blocks from a faster peer: blocks just
+    /// above the tip that have spent more than half the download timeout in
+    /// flight on a peer with lower measured throughput are reassigned to
+    /// `peer`, so one slow peer does not stall the whole download window.
+    /// Returns the reassigned blocks, at most `max` of them.
+    pub fn steal_tail_blocks(
+        &mut self,
+        peer: PeerIndex,
+        tip: BlockNumber,
+        max: usize,
+    ) -> Vec<BlockNumberAndHash> {
+        const STEAL_TAIL_WINDOW: BlockNumber = 4;
+
+        let peer_throughput = self
+            .download_schedulers
+            .get(&peer)
+            .map(DownloadScheduler::throughput)
+            .unwrap_or(0);
+        if peer_throughput == 0 || max == 0 {
+            return Vec::new();
+        }
+
+        let now = unix_time_as_millis();
+        let mut stolen = Vec::new();
+        for (key, state) in self.inflight_states.iter() {
+            if key.number > tip + STEAL_TAIL_WINDOW || stolen.len() >= max {
+                break;
+            }
+            if state.peer == peer || state.timestamp + BLOCK_DOWNLOAD_TIMEOUT / 2 > now {
+                continue;
+            }
+            let origin_throughput = self
+                .download_schedulers
+                .get(&state.peer)
+                .map(DownloadScheduler::throughput)
+                .unwrap_or(0);
+            if origin_throughput >= peer_throughput {
+                continue;
+            }
+            stolen.push(key.clone());
+        }
+
+        for key in &stolen {
+            if let Some(state) = self.inflight_states.remove(key) {
+                if let Some(set) = self.download_schedulers.get_mut(&state.peer) {
+                    set.hashes.remove(key);
+                }
+            }
+            self.inflight_states
+                .insert(key.clone(), InflightState::new(peer));
+            self.download_schedulers
+                .entry(peer)
+                .or_insert_with(DownloadScheduler::default)
+                .hashes
+                .insert(key.clone());
+            self.trace_number.remove(key);
+        }
+        stolen
+    }
 }
 
 impl Peers {
@@ -1164,7 +1273,7 @@ impl SyncShared {
     pub fn new(
         shared: Shared,
         sync_config: SyncConfig,
-        tx_relay_receiver: Receiver<(Option<PeerIndex>, bool, Byte32)>,
+        tx_relay_receiver: Receiver<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
     ) -> SyncShared {
         Self::with_tmpdir::<PathBuf>(shared, sync_config, None, tx_relay_receiver)
     }
@@ -1174,7 +1283,7 @@ impl SyncShared {
         shared: Shared,
         sync_config: SyncConfig,
         tmpdir: Option<P>,
-        tx_relay_receiver: Receiver<(Option<PeerIndex>, bool, Byte32)>,
+        tx_relay_receiver: Receiver<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
     ) -> SyncShared
     where
         P: AsRef<Path>,
@@ -1210,6 +1319,8 @@ impl SyncShared {
             inflight_blocks: RwLock::new(InflightBlocks::default()),
             pending_get_headers: RwLock::new(LruCache::new(GET_HEADERS_CACHE_SIZE)),
             tx_relay_receiver,
+            tx_relay_queue: Mutex::new(BinaryHeap::new()),
+            tx_relay_seq: AtomicU64::new(0),
             assume_valid_target: Mutex::new(sync_config.assume_valid_target),
             min_chain_work: sync_config.min_chain_work,
         };
@@ -1524,11 +1635,47 @@ pub struct SyncState {
     inflight_blocks: RwLock<InflightBlocks>,
 
     /* cached for sending bulk */
-    tx_relay_receiver: Receiver<(Option<PeerIndex>, bool, Byte32)>,
+    tx_relay_receiver: Receiver<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
+    /* announcements drained from the channel, relayed highest fee rate first */
+    tx_relay_queue: Mutex<BinaryHeap<TxAnnouncement>>,
+    tx_relay_seq: AtomicU64,
     assume_valid_target: Mutex<Option<H256>>,
     min_chain_work: U256,
 }
 
+/// A queued transaction announcement. Ordered by fee rate, highest first,
+/// with arrival order as the tiebreak, so settlement-grade transactions do
+/// not wait behind a flood of dust announcements.
+struct TxAnnouncement {
+    fee_rate: FeeRate,
+    seq: u64,
+    origin: Option<PeerIndex>,
+    ckb2021: bool,
+    hash: Byte32,
+}
+
+impl PartialEq for TxAnnouncement {
+    fn eq(&self, other: &Self) -> bool {
+        self.seq == other.seq
+    }
+}
+
+impl Eq for TxAnnouncement {}
+
+impl PartialOrd for TxAnnouncement {
+    fn partial_cmp(&self, other: &Self) -> Option<::std::cmp::Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+impl Ord for TxAnnouncement {
+    fn cmp(&self, other: &Self) -> ::std::cmp::Ordering {
+        self.fee_rate
+            .cmp(&other.fee_rate)
+            .then_with(|| other.seq.cmp(&self.seq))
+    }
+}
+
 impl SyncState {
     pub fn assume_valid_target(&self) -> MutexGuard<Option<H256>> {
         self.assume_valid_target.lock()
@@ -1577,7 +1724,29 @@ impl SyncState {
     }
 
     pub fn take_relay_tx_hashes(&self, limit: usize) -> Vec<(Option<PeerIndex>, bool, Byte32)> {
-        self.tx_relay_receiver.try_iter().take(limit).collect()
+        let mut queue = self.tx_relay_queue.lock();
+        for (origin, ckb2021, hash, fee_rate) in self.tx_relay_receiver.try_iter() {
+            let seq = self.tx_relay_seq.fetch_add(1, Ordering::Relaxed);
+            queue.push(TxAnnouncement {
+                fee_rate,
+                seq,
+                origin,
+                ckb2021,
+                hash,
+            });
+        }
+        let mut hashes = Vec::with_capacity(::std::cmp::min(limit, queue.len()));
+        while hashes.len() < limit {
+            match queue.pop() {
+                Some(announcement) => hashes.push((
+                    announcement.origin,
+                    announcement.ckb2021,
+                    announcement.hash,
+                )),
+                None => break,
+            }
+        }
+        hashes
     }
 
     pub fn shared_best_header(&self) -> HeaderView {
@@ -1702,10 +1871,10 @@ impl SyncState {
 
     // Return true when the block is that we have requested and received first time.
     pub fn new_block_received(&self, block: &core::BlockView) -> bool {
-        if self
-            .write_inflight_blocks()
-            .remove_by_block((block.number(), block.hash()).into())
-        {
+        if self.write_inflight_blocks().remove_by_block(
+            (block.number(), block.hash()).into(),
+            block.data().as_slice().len() as u64,
+        ) {
             self.insert_block_status(block.hash(), BlockStatus::BLOCK_RECEIVED);
             true
         } else {
@@ -1727,7 +1896,12 @@ impl SyncState {
 
     pub fn insert_orphan_block(&self, block: core::BlockView) {
         self.insert_block_status(block.hash(), BlockStatus::BLOCK_RECEIVED);
-        self.orphan_block_pool.insert(block);
+        let evicted = self.orphan_block_pool.insert(block);
+        // evicted orphans must lose their BLOCK_RECEIVED status, otherwise
+        // they would never be requested again
+        for hash in evicted {
+            self.remove_block_status(&hash);
+        }
     }
 
     pub fn remove_orphan_by_parent(&self, parent_hash: &Byte32) -> Vec<core::BlockView> {
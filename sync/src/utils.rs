@@ -47,6 +47,38 @@ pub(crate) fn send_message_to<Message: Entity>(
     send_message(protocol_id, nc, peer_index, message)
 }
 
+/// Send network message through the peer's high-priority queue, jumping
+/// ahead of queued bulk traffic such as block download responses.
+///
+/// Equal to `nc.quick_send_message_to`. Reserved for latency-sensitive
+/// messages on the block propagation path; bulk data sent through it would
+/// defeat the prioritization.
+#[must_use]
+pub(crate) fn quick_send_message_to<Message: Entity>(
+    nc: &dyn CKBProtocolContext,
+    peer_index: PeerIndex,
+    message: &Message,
+) -> Status {
+    let protocol_id = nc.protocol_id();
+    if let Err(err) = nc.quick_send_message_to(peer_index, message.as_bytes()) {
+        let name = message_name(protocol_id, message);
+        let error_message = format!("nc.quick_send_message_to {}, error: {:?}", name, err);
+        ckb_logger::error!("{}", error_message);
+        return StatusCode::Network.with_context(error_message);
+    }
+
+    let bytes = message.as_bytes().len() as u64;
+    let item_id = item_id(protocol_id, message);
+    metrics!(
+        counter,
+        "ckb.messages_bytes", bytes,
+        "direction" => "out",
+        "protocol_id" => protocol_id.value().to_string(),
+        "item_id" => item_id.to_string(),
+    );
+    Status::ok()
+}
+
 // As for Sync protocol and Relay protocol, returns the internal item name;
 // otherwise returns the entity name.
 fn message_name<Message: Entity>(protocol_id: ProtocolId, message: &Message) -> String {
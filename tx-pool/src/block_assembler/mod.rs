@@ -32,6 +32,10 @@ pub struct TemplateCache {
     pub time: u64,
     pub uncles_updated_at: u64,
     pub txs_updated_at: u64,
+    // selection state kept for incremental template updates
+    pub committed: Vec<ProposalShortId>,
+    pub txs_size: usize,
+    pub txs_cycles: Cycle,
     pub template: BlockTemplate,
 }
 
@@ -6,7 +6,10 @@ use ckb_channel::{select, Receiver};
 use ckb_error::Error;
 use ckb_store::ChainStore;
 use ckb_traits::{CellDataProvider, HeaderProvider};
-use ckb_types::{core::Cycle, packed::Byte32};
+use ckb_types::{
+    core::Cycle,
+    packed::{Byte32, ProposalShortId},
+};
 use ckb_verification::{
     cache::{CacheEntry, Completed},
     ContextualWithoutScriptTransactionVerifier, ScriptError, ScriptGroupType, ScriptVerifier,
@@ -17,6 +20,10 @@ use std::sync::Arc;
 
 const MIN_STEP_CYCLE: Cycle = 10_000_000;
 
+/// Number of chunk verify workers pulling entries from the shared queue, so
+/// one cycle-heavy transaction no longer blocks the ones queued behind it.
+pub(crate) const CHUNK_VERIFY_WORKERS: usize = 4;
+
 type Stop = bool;
 
 #[derive(Eq, PartialEq, Clone, Debug)]
@@ -93,16 +100,22 @@ impl TxChunkProcess {
         self.service.chunk.write().await.pop_front()
     }
 
-    async fn remove_front(&self) {
+    async fn finish(&self, id: &ProposalShortId) {
+        let mut guard = self.service.chunk.write().await;
+        guard.finish(id);
+    }
+
+    async fn requeue(&self, entry: Entry) {
         let mut guard = self.service.chunk.write().await;
-        guard.clean_front();
+        guard.requeue(entry);
     }
 
     fn process(&mut self, entry: Entry) -> Stop {
+        let id = entry.tx.proposal_short_id();
         self.process_inner(entry.clone()).unwrap_or_else(|e| {
             self.handle
                 .block_on(self.service.after_process(entry.tx, entry.remote, &Err(e)));
-            self.handle.block_on(self.remove_front());
+            self.handle.block_on(self.finish(&id));
             false
         })
     }
@@ -141,9 +154,10 @@ impl TxChunkProcess {
                         self.service
                             .submit_entry(completed, tip_hash, entry, status),
                     )?;
+                    let id = tx.proposal_short_id();
                     self.handle
                         .block_on(self.service.after_process(tx, remote, &Ok(completed)));
-                    self.handle.block_on(self.remove_front());
+                    self.handle.block_on(self.finish(&id));
                     return Ok(false);
                 }
                 CacheEntry::Suspended(suspended) => {
@@ -175,11 +189,19 @@ impl TxChunkProcess {
                         if let Some(state) = state {
                             let snap = state.try_into().map_err(Reject::Verification)?;
                             let txs_verify_cache = Arc::clone(&self.service.txs_verify_cache);
+                            let cached_tx_hash = tx_hash.clone();
                             self.handle.block_on(async move {
-                                let mut guard = txs_verify_cache.write().await;
-                                guard.put(tx_hash, CacheEntry::suspended(Arc::new(snap), fee));
+                                txs_verify_cache
+                                    .put(cached_tx_hash, CacheEntry::suspended(Arc::new(snap), fee))
+                                    .await;
                             })
                         }
+                        // release the claim so any continued worker resumes
+                        // this entry from the cached snapshot
+                        self.handle.block_on(self.requeue(Entry {
+                            tx: tx.clone(),
+                            remote,
+                        }));
                         self.p_state = ProcessState::Interrupt;
                         return Ok(false);
                     }
@@ -254,15 +276,17 @@ impl TxChunkProcess {
             self.service
                 .submit_entry(completed, tip_hash, entry, status),
         )?;
+        let id = tx.proposal_short_id();
         self.handle
             .block_on(self.service.after_process(tx, remote, &Ok(completed)));
 
-        self.handle.block_on(self.remove_front());
+        self.handle.block_on(self.finish(&id));
 
         let txs_verify_cache = Arc::clone(&self.service.txs_verify_cache);
         self.handle.block_on(async move {
-            let mut guard = txs_verify_cache.write().await;
-            guard.put(tx_hash, CacheEntry::Completed(completed));
+            txs_verify_cache
+                .put(tx_hash, CacheEntry::Completed(completed))
+                .await;
         });
 
         Ok(false)
@@ -4,6 +4,7 @@ use ckb_types::{
     packed::ProposalShortId,
 };
 use ckb_util::{shrink_to_fit, LinkedHashMap};
+use std::collections::{HashSet, VecDeque};
 
 const SHRINK_THRESHOLD: usize = 100;
 pub(crate) const DEFAULT_MAX_CHUNK_TRANSACTIONS: usize = 100;
@@ -23,25 +24,28 @@ impl PartialEq for Entry {
 #[derive(Default)]
 pub(crate) struct ChunkQueue {
     inner: LinkedHashMap<ProposalShortId, Entry>,
-    // memory last pop value for atomic reset
-    front: Option<Entry>,
+    // entries put back by suspended workers, retried before the queue
+    requeued: VecDeque<Entry>,
+    // entries currently claimed by verify workers
+    in_flight: HashSet<ProposalShortId>,
 }
 
 impl ChunkQueue {
     pub(crate) fn new() -> Self {
         ChunkQueue {
             inner: LinkedHashMap::default(),
-            front: None,
+            requeued: VecDeque::new(),
+            in_flight: HashSet::new(),
         }
     }
 
     pub fn len(&self) -> usize {
-        self.inner.len()
+        self.inner.len() + self.requeued.len() + self.in_flight.len()
     }
 
     #[allow(dead_code)]
     pub fn is_empty(&self) -> bool {
-        self.inner.is_empty()
+        self.len() == 0
     }
 
     pub fn is_full(&self) -> bool {
@@ -49,37 +53,53 @@ impl ChunkQueue {
     }
 
     pub fn contains_key(&self, id: &ProposalShortId) -> bool {
-        self.front
-            .as_ref()
-            .map(|e| e.tx.proposal_short_id())
-            .as_ref()
-            == Some(id)
+        self.in_flight.contains(id)
             || self.inner.contains_key(id)
+            || self
+                .requeued
+                .iter()
+                .any(|e| &e.tx.proposal_short_id() == id)
     }
 
     pub fn shrink_to_fit(&mut self) {
         shrink_to_fit!(self.inner, SHRINK_THRESHOLD);
     }
 
-    pub fn clean_front(&mut self) {
-        self.front = None;
+    /// Claims the next entry for a verify worker; the entry stays accounted
+    /// here (in flight) until `finish` or `requeue`.
+    pub fn pop_front(&mut self) -> Option<Entry> {
+        let entry = match self.requeued.pop_front() {
+            Some(entry) => entry,
+            None => match self.inner.pop_front() {
+                Some((_id, entry)) => entry,
+                None => return None,
+            },
+        };
+        self.in_flight.insert(entry.tx.proposal_short_id());
+        Some(entry)
     }
 
-    pub fn pop_front(&mut self) -> Option<Entry> {
-        if let Some(entry) = &self.front {
-            Some(entry.clone())
-        } else {
-            match self.inner.pop_front() {
-                Some((_id, entry)) => {
-                    self.front = Some(entry.clone());
-                    Some(entry)
-                }
-                None => None,
-            }
-        }
+    /// Releases a claimed entry after it completed or was rejected.
+    pub fn finish(&mut self, id: &ProposalShortId) {
+        self.in_flight.remove(id);
+    }
+
+    /// Puts a claimed entry back for a later retry, keeping its position
+    /// ahead of unclaimed entries; used when a worker suspends with the
+    /// verification state parked in the verify cache.
+    pub fn requeue(&mut self, entry: Entry) {
+        self.in_flight.remove(&entry.tx.proposal_short_id());
+        self.requeued.push_back(entry);
     }
 
     pub fn remove_chunk_tx(&mut self, id: &ProposalShortId) -> Option<Entry> {
+        if let Some(pos) = self
+            .requeued
+            .iter()
+            .position(|e| &e.tx.proposal_short_id() == id)
+        {
+            return self.requeued.remove(pos);
+        }
         self.inner.remove(id)
     }
 
@@ -123,7 +143,8 @@ impl ChunkQueue {
 
     pub fn clear(&mut self) {
         self.inner.clear();
-        self.clean_front();
+        self.requeued.clear();
+        self.in_flight.clear();
         self.shrink_to_fit()
     }
 }
@@ -131,7 +152,7 @@ impl ChunkQueue {
 #[cfg(test)]
 mod tests {
     use super::*;
-    use ckb_types::core::TransactionBuilder;
+    use ckb_types::{core::TransactionBuilder, prelude::*};
 
     #[test]
     fn basic() {
@@ -148,7 +169,30 @@ mod tests {
         assert!(queue.contains_key(&id));
         assert!(!queue.add_tx(tx));
 
-        queue.clean_front();
+        queue.finish(&id);
         assert!(!queue.contains_key(&id));
     }
+
+    #[test]
+    fn requeue_retries_before_queue() {
+        let tx1 = TransactionBuilder::default().version(1u32.pack()).build();
+        let tx2 = TransactionBuilder::default().version(2u32.pack()).build();
+        let mut queue = ChunkQueue::new();
+
+        assert!(queue.add_tx(tx1.clone()));
+        assert!(queue.add_tx(tx2.clone()));
+
+        // two workers claim both entries, the first suspends
+        let entry1 = queue.pop_front().unwrap();
+        let entry2 = queue.pop_front().unwrap();
+        assert_eq!(entry1.tx, tx1);
+        assert_eq!(entry2.tx, tx2);
+        assert!(queue.pop_front().is_none());
+
+        queue.requeue(entry1);
+        assert!(queue.contains_key(&tx1.proposal_short_id()));
+        // the suspended entry is claimed again before new additions
+        assert!(queue.add_tx(TransactionBuilder::default().version(3u32.pack()).build()));
+        assert_eq!(queue.pop_front().unwrap().tx, tx1);
+    }
 }
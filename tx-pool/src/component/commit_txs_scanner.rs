@@ -183,6 +183,53 @@ impl<'a> CommitTxsScanner<'a> {
         (self.entries, size, cycles)
     }
 
+    /// Appends newly proposed txs to an existing selection without re-running
+    /// the full scan: walks the score-sorted index taking entries whose
+    /// unconfirmed ancestors are all already selected and which fit into the
+    /// remaining block budget, so the template's topological order stays
+    /// valid. A full scan may find a better packing, so this is only used for
+    /// delta updates between reorgs; returns the appended entries with the
+    /// new total size and cycles.
+    pub fn txs_to_append(
+        proposed_pool: &ProposedPool,
+        selected: &HashSet<ProposalShortId>,
+        size_limit: usize,
+        cycles_limit: Cycle,
+        current_size: usize,
+        current_cycles: Cycle,
+    ) -> (Vec<TxEntry>, usize, Cycle) {
+        let mut appended = Vec::new();
+        let mut size = current_size;
+        let mut cycles = current_cycles;
+        let mut selected: HashSet<ProposalShortId> = selected.clone();
+        let mut consecutive_failed = 0;
+
+        for entry in proposed_pool.score_sorted_iter() {
+            let short_id = entry.proposal_short_id();
+            if selected.contains(&short_id) {
+                continue;
+            }
+            let next_size = size.saturating_add(entry.size);
+            let next_cycles = cycles.saturating_add(entry.cycles);
+            let ancestors = proposed_pool.calc_ancestors(&short_id);
+            if next_size > size_limit
+                || next_cycles > cycles_limit
+                || !ancestors.iter().all(|id| selected.contains(id))
+            {
+                consecutive_failed += 1;
+                if consecutive_failed > MAX_CONSECUTIVE_FAILURES {
+                    break;
+                }
+                continue;
+            }
+            selected.insert(short_id);
+            size = next_size;
+            cycles = next_cycles;
+            appended.push(entry.to_owned());
+        }
+        (appended, size, cycles)
+    }
+
     fn retrieve_entry(&self, short_id: &ProposalShortId) -> Option<&TxEntry> {
         self.modified_entries
             .get(short_id)
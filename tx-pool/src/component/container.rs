@@ -6,7 +6,6 @@ use ckb_types::{
     core::Capacity,
     packed::{OutPoint, ProposalShortId},
 };
-use std::borrow::Cow;
 use std::cmp::Ordering;
 use std::collections::hash_map::Entry as HashMapEntry;
 use std::collections::{BTreeSet, HashMap, HashSet};
@@ -85,27 +84,24 @@ impl TxLinks {
 }
 
 fn calc_relation_ids(
-    stage: Cow<HashSet<ProposalShortId>>,
+    direct: &HashSet<ProposalShortId>,
     map: &TxLinksMap,
     relation: Relation,
 ) -> HashSet<ProposalShortId> {
-    let mut stage = stage.into_owned();
-    let mut relation_ids = HashSet::with_capacity(stage.len());
+    let mut relation_ids = HashSet::with_capacity(direct.len());
+    let mut stage: Vec<ProposalShortId> = direct.iter().cloned().collect();
 
-    while let Some(id) = stage.iter().next().cloned() {
-        relation_ids.insert(id.clone());
-        stage.remove(&id);
+    while let Some(id) = stage.pop() {
+        if !relation_ids.insert(id.clone()) {
+            continue;
+        }
 
         //recursively
-        for id in map
-            .inner
-            .get(&id)
-            .map(|link| link.get_direct_ids(relation))
-            .cloned()
-            .unwrap_or_default()
-        {
-            if !relation_ids.contains(&id) {
-                stage.insert(id);
+        if let Some(link) = map.inner.get(&id) {
+            for next in link.get_direct_ids(relation) {
+                if !relation_ids.contains(next) {
+                    stage.push(next.clone());
+                }
             }
         }
     }
@@ -129,14 +125,10 @@ impl TxLinksMap {
         short_id: &ProposalShortId,
         relation: Relation,
     ) -> HashSet<ProposalShortId> {
-        let direct = self
-            .inner
-            .get(short_id)
-            .map(|link| link.get_direct_ids(relation))
-            .cloned()
-            .unwrap_or_default();
-
-        calc_relation_ids(Cow::Owned(direct), &self, relation)
+        match self.inner.get(short_id) {
+            Some(link) => calc_relation_ids(link.get_direct_ids(relation), self, relation),
+            None => HashSet::new(),
+        }
     }
 
     pub fn calc_ancestors(&self, short_id: &ProposalShortId) -> HashSet<ProposalShortId> {
@@ -257,7 +249,7 @@ impl SortedTxMap {
                 .insert(short_id.clone());
         }
 
-        let ancestors = calc_relation_ids(Cow::Borrowed(&parents), &self.links, Relation::Parents);
+        let ancestors = calc_relation_ids(&parents, &self.links, Relation::Parents);
 
         // update parents references
         for ancestor_id in &ancestors {
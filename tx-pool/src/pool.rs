@@ -22,6 +22,7 @@ use ckb_types::{
     packed::{Byte32, OutPoint, ProposalShortId},
 };
 use ckb_verification::{cache::CacheEntry, TxVerifyEnv};
+use dashmap::DashMap;
 use faketime::unix_time_as_millis;
 use lru::LruCache;
 use std::collections::HashSet;
@@ -49,6 +50,9 @@ pub struct TxPool {
     pub(crate) total_tx_cycles: Cycle,
     /// storage snapshot reference
     pub(crate) snapshot: Arc<Snapshot>,
+    /// short-id index over every tx in the pool, shared with the controller
+    /// for synchronous compact block reconstruction lookups
+    pub(crate) short_id_index: Arc<DashMap<ProposalShortId, TransactionView>>,
 }
 
 /// Transaction pool information.
@@ -89,9 +93,11 @@ impl TxPool {
         config: TxPoolConfig,
         snapshot: Arc<Snapshot>,
         last_txs_updated_at: Arc<AtomicU64>,
+        short_id_index: Arc<DashMap<ProposalShortId, TransactionView>>,
     ) -> TxPool {
         const COMMITTED_HASH_CACHE_SIZE: usize = 100_000;
 
+        short_id_index.clear();
         TxPool {
             config,
             pending: PendingQueue::new(),
@@ -102,6 +108,7 @@ impl TxPool {
             total_tx_size: 0,
             total_tx_cycles: 0,
             snapshot,
+            short_id_index,
         }
     }
 
@@ -174,12 +181,16 @@ impl TxPool {
             return false;
         }
         trace!("add_pending {}", entry.transaction().hash());
+        self.short_id_index
+            .insert(entry.proposal_short_id(), entry.transaction().clone());
         self.pending.add_entry(entry).is_none()
     }
 
     /// Add tx which proposed but still uncommittable to gap pool
     pub fn add_gap(&mut self, entry: TxEntry) -> bool {
         trace!("add_gap {}", entry.transaction().hash());
+        self.short_id_index
+            .insert(entry.proposal_short_id(), entry.transaction().clone());
         self.gap.add_entry(entry).is_none()
     }
 
@@ -187,6 +198,8 @@ impl TxPool {
     pub fn add_proposed(&mut self, entry: TxEntry) -> Result<bool, Reject> {
         trace!("add_proposed {}", entry.transaction().hash());
         self.touch_last_txs_updated_at();
+        self.short_id_index
+            .insert(entry.proposal_short_id(), entry.transaction().clone());
         self.proposed.add_entry(entry)
     }
 
@@ -260,6 +273,7 @@ impl TxPool {
         for (tx, related_out_points) in txs {
             let hash = tx.hash();
             trace!("committed {}", hash);
+            self.short_id_index.remove(&tx.proposal_short_id());
             // try remove committed tx from proposed
             if let Some(entry) = self.proposed.remove_committed_tx(tx, &related_out_points) {
                 callbacks.call_committed(self, &entry)
@@ -268,10 +282,12 @@ impl TxPool {
                 let (input_conflict, deps_consumed) = self.proposed.resolve_conflict(tx);
 
                 for (entry, reject) in input_conflict {
+                    self.short_id_index.remove(&entry.proposal_short_id());
                     callbacks.call_reject(self, &entry, reject);
                 }
 
                 for (entry, reject) in deps_consumed {
+                    self.short_id_index.remove(&entry.proposal_short_id());
                     callbacks.call_reject(self, &entry, reject);
                 }
             }
@@ -386,7 +402,14 @@ impl TxPool {
         self.check_rtx_from_pending_and_proposed(&rtx, resolve_opts)?;
 
         let max_cycles = snapshot.consensus().max_block_cycles();
-        let verified = verify_rtx(snapshot, &rtx, &tx_env, &cache_entry, max_cycles)?;
+        let verified = verify_rtx(
+            snapshot,
+            &rtx,
+            &tx_env,
+            &cache_entry,
+            max_cycles,
+            self.config.parallel_script_verify,
+        )?;
 
         let entry = TxEntry::new(rtx, verified.cycles, verified.fee, size);
         let tx_hash = entry.transaction().hash();
@@ -417,7 +440,14 @@ impl TxPool {
         self.check_rtx_from_proposed(&rtx, resolve_opts)?;
 
         let max_cycles = snapshot.consensus().max_block_cycles();
-        let verified = verify_rtx(snapshot, &rtx, &tx_env, &cache_entry, max_cycles)?;
+        let verified = verify_rtx(
+            snapshot,
+            &rtx,
+            &tx_env,
+            &cache_entry,
+            max_cycles,
+            self.config.parallel_script_verify,
+        )?;
 
         let entry = TxEntry::new(rtx, verified.cycles, verified.fee, size);
         let tx_hash = entry.transaction().hash();
@@ -503,6 +533,7 @@ impl TxPool {
         self.proposed.clear();
         txs.append(&mut self.gap.drain());
         txs.append(&mut self.pending.drain());
+        self.short_id_index.clear();
         txs
     }
 }
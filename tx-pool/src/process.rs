@@ -16,6 +16,7 @@ use ckb_dao::DaoCalculator;
 use ckb_error::{AnyError, InternalErrorKind};
 use ckb_jsonrpc_types::BlockTemplate;
 use ckb_logger::{debug, error, info, warn};
+use ckb_metrics::{metrics, Timer};
 use ckb_network::PeerIndex;
 use ckb_snapshot::Snapshot;
 use ckb_store::ChainStore;
@@ -26,7 +27,7 @@ use ckb_types::{
             TransactionsChecker,
         },
         hardfork::HardForkSwitch,
-        BlockView, Capacity, Cycle, EpochExt, HeaderView, ScriptHashType, TransactionView,
+        BlockView, Capacity, Cycle, EpochExt, FeeRate, HeaderView, ScriptHashType, TransactionView,
         UncleBlockView, Version,
     },
     packed::{Byte32, CellbaseWitness, OutPoint, ProposalShortId, Script},
@@ -118,6 +119,127 @@ impl TxPoolService {
         None
     }
 
+    /// Incremental fast path for template rebuilds: when the cached template
+    /// for the same tip only became stale because new transactions were
+    /// proposed, append the best-scored newcomers that fit the remaining
+    /// budget instead of re-running the full commit scan over the pool.
+    /// Reorgs change the tip (and with it the cache key) and prune the pool;
+    /// both the key lookup and the entry fetch below fall back to the full
+    /// scan in that case.
+    async fn try_append_to_block_template(
+        &self,
+        bytes_limit: u64,
+        proposals_limit: u64,
+        version: Version,
+        snapshot: &Snapshot,
+        block_assembler: &BlockAssembler,
+    ) -> Option<BlockTemplate> {
+        let tip_hash = snapshot.tip_header().hash();
+        let last_uncles_updated_at = block_assembler
+            .last_uncles_updated_at
+            .load(Ordering::SeqCst);
+
+        let (cached_committed, cached_size, cached_cycles) = {
+            let guard = block_assembler.template_caches.lock().await;
+            let cache = guard.peek(&(tip_hash.clone(), bytes_limit, proposals_limit, version))?;
+            if cache.uncles_updated_at != last_uncles_updated_at {
+                return None;
+            }
+            (cache.committed.clone(), cache.txs_size, cache.txs_cycles)
+        };
+
+        let consensus = snapshot.consensus();
+        let cycles_limit = consensus.max_block_cycles();
+
+        let cellbase = self
+            .build_block_template_cellbase(snapshot, &block_assembler.config)
+            .ok()?;
+        let (uncles, current_epoch, uncles_updated_at) = self
+            .prepare_block_template_uncles(snapshot, block_assembler)
+            .await;
+        if uncles_updated_at != last_uncles_updated_at {
+            return None;
+        }
+
+        let (proposals, entries, txs_updated_at, txs_size, txs_cycles, committed) = {
+            let guard = self.tx_pool.read().await;
+            let uncle_proposals = uncles
+                .iter()
+                .flat_map(|u| u.data().proposals().into_iter())
+                .collect();
+            let proposals = guard.get_proposals(proposals_limit as usize, &uncle_proposals);
+            let txs_size_limit = BlockAssembler::calculate_txs_size_limit(
+                bytes_limit,
+                cellbase.data(),
+                &uncles,
+                &proposals,
+            )
+            .ok()?;
+            // the proposals section grows with the pool, shrinking the size
+            // budget; when the cached selection no longer fits, only the
+            // full scan can shed entries
+            if cached_size > txs_size_limit {
+                return None;
+            }
+
+            // every previously selected entry must still be in the pool,
+            // otherwise the pool was pruned and the full scan must run
+            let mut entries = Vec::with_capacity(cached_committed.len());
+            for id in &cached_committed {
+                entries.push(guard.proposed().get(id)?.to_owned());
+            }
+            let selected: HashSet<ProposalShortId> = cached_committed.iter().cloned().collect();
+            let (appended, txs_size, txs_cycles) = CommitTxsScanner::txs_to_append(
+                guard.proposed(),
+                &selected,
+                txs_size_limit,
+                cycles_limit,
+                cached_size,
+                cached_cycles,
+            );
+            let mut committed = cached_committed;
+            committed.extend(appended.iter().map(TxEntry::proposal_short_id));
+            entries.extend(appended);
+            (
+                proposals,
+                entries,
+                guard.get_last_txs_updated_at(),
+                txs_size,
+                txs_cycles,
+                committed,
+            )
+        };
+
+        let work_id = block_assembler.work_id.fetch_add(1, Ordering::SeqCst);
+        let block_template = self
+            .build_block_template(
+                snapshot,
+                entries,
+                proposals,
+                cellbase,
+                work_id,
+                current_epoch,
+                uncles,
+                bytes_limit,
+                version,
+            )
+            .ok()?;
+
+        self.update_block_template_cache(
+            block_assembler,
+            (tip_hash, bytes_limit, proposals_limit, version),
+            uncles_updated_at,
+            txs_updated_at,
+            committed,
+            txs_size,
+            txs_cycles,
+            block_template.clone(),
+        )
+        .await;
+
+        Some(block_template)
+    }
+
     fn build_block_template_cellbase(
         &self,
         snapshot: &Snapshot,
@@ -181,7 +303,7 @@ impl TxPoolService {
         max_block_cycles: Cycle,
         cellbase: &TransactionView,
         uncles: &[UncleBlockView],
-    ) -> Result<(HashSet<ProposalShortId>, Vec<TxEntry>, u64), AnyError> {
+    ) -> Result<(HashSet<ProposalShortId>, Vec<TxEntry>, u64, usize, Cycle), AnyError> {
         let guard = self.tx_pool.read().await;
         let uncle_proposals = uncles
             .iter()
@@ -210,7 +332,7 @@ impl TxPoolService {
             );
         }
         let last_txs_updated_at = self.last_txs_updated_at.load(Ordering::SeqCst);
-        Ok((proposals, entries, last_txs_updated_at))
+        Ok((proposals, entries, last_txs_updated_at, size, cycles))
     }
 
     #[allow(clippy::too_many_arguments)]
@@ -306,12 +428,16 @@ impl TxPoolService {
         })
     }
 
+    #[allow(clippy::too_many_arguments)]
     async fn update_block_template_cache(
         &self,
         block_assembler: &BlockAssembler,
         key: BlockTemplateCacheKey,
         uncles_updated_at: u64,
         txs_updated_at: u64,
+        committed: Vec<ProposalShortId>,
+        txs_size: usize,
+        txs_cycles: Cycle,
         template: BlockTemplate,
     ) {
         block_assembler.template_caches.lock().await.put(
@@ -320,6 +446,9 @@ impl TxPoolService {
                 time: template.current_time.into(),
                 uncles_updated_at,
                 txs_updated_at,
+                committed,
+                txs_size,
+                txs_cycles,
                 template,
             },
         );
@@ -363,6 +492,19 @@ impl TxPoolService {
                 return Ok(cache);
             }
 
+            if let Some(template) = self
+                .try_append_to_block_template(
+                    bytes_limit,
+                    proposals_limit,
+                    version,
+                    &snapshot,
+                    &block_assembler,
+                )
+                .await
+            {
+                return Ok(template);
+            }
+
             let cellbase =
                 self.build_block_template_cellbase(&snapshot, &block_assembler.config)?;
 
@@ -370,7 +512,7 @@ impl TxPoolService {
                 .prepare_block_template_uncles(&snapshot, &block_assembler)
                 .await;
 
-            let (proposals, entries, txs_updated_at) = self
+            let (proposals, entries, txs_updated_at, txs_size, txs_cycles) = self
                 .package_txs_for_block_template(
                     bytes_limit,
                     proposals_limit,
@@ -380,6 +522,8 @@ impl TxPoolService {
                 )
                 .await?;
 
+            let committed: Vec<ProposalShortId> =
+                entries.iter().map(TxEntry::proposal_short_id).collect();
             let work_id = block_assembler.work_id.fetch_add(1, Ordering::SeqCst);
 
             let block_template = self.build_block_template(
@@ -399,6 +543,9 @@ impl TxPoolService {
                 (snapshot.tip_hash(), bytes_limit, proposals_limit, version),
                 uncles_updated_at,
                 txs_updated_at,
+                committed,
+                txs_size,
+                txs_cycles,
                 block_template.clone(),
             )
             .await;
@@ -408,20 +555,15 @@ impl TxPoolService {
     }
 
     pub(crate) async fn fetch_tx_verify_cache(&self, hash: &Byte32) -> Option<CacheEntry> {
-        let guard = self.txs_verify_cache.read().await;
-        guard.peek(hash).cloned()
+        self.txs_verify_cache.get(hash).await
     }
 
     async fn fetch_txs_verify_cache(
         &self,
         txs: impl Iterator<Item = &TransactionView>,
     ) -> HashMap<Byte32, CacheEntry> {
-        let guard = self.txs_verify_cache.read().await;
-        txs.filter_map(|tx| {
-            let hash = tx.hash();
-            guard.peek(&hash).cloned().map(|value| (hash, value))
-        })
-        .collect()
+        let keys: Vec<Byte32> = txs.map(|tx| tx.hash()).collect();
+        self.txs_verify_cache.fetch(keys).await
     }
 
     pub(crate) async fn submit_entry(
@@ -543,7 +685,9 @@ impl TxPoolService {
             Some((declared_cycle, peer)) => match ret {
                 Ok(verified) => {
                     if declared_cycle == verified.cycles {
-                        self.broadcast_tx(Some(peer), tx_hash, with_vm_2021);
+                        let fee_rate =
+                            FeeRate::calculate(verified.fee, tx.data().serialized_size_in_block());
+                        self.broadcast_tx(Some(peer), tx_hash, with_vm_2021, fee_rate);
                         self.process_orphan_tx(&tx).await;
                     } else {
                         warn!(
@@ -569,13 +713,16 @@ impl TxPoolService {
             },
             None => {
                 match ret {
-                    Ok(_) => {
-                        self.broadcast_tx(None, tx_hash, with_vm_2021);
+                    Ok(verified) => {
+                        let fee_rate =
+                            FeeRate::calculate(verified.fee, tx.data().serialized_size_in_block());
+                        self.broadcast_tx(None, tx_hash, with_vm_2021, fee_rate);
                         self.process_orphan_tx(&tx).await;
                     }
                     Err(Reject::Duplicated(_)) => {
-                        // re-broadcast tx when it's duplicated and submitted through local rpc
-                        self.broadcast_tx(None, tx_hash, with_vm_2021);
+                        // re-broadcast tx when it's duplicated and submitted through
+                        // local rpc; the fee is unknown here, relay at base priority
+                        self.broadcast_tx(None, tx_hash, with_vm_2021, FeeRate::zero());
                     }
                     Err(_err) => {
                         // ignore
@@ -627,15 +774,24 @@ impl TxPoolService {
                         .add_remote_tx(orphan.tx, (orphan.cycle, orphan.peer));
                 } else {
                     match self._process_tx(orphan.tx.clone(), None).await {
-                        Ok(_) => {
+                        Ok(verified) => {
                             let with_vm_2021 = {
                                 let epoch = self.snapshot().tip_header().epoch().number();
                                 self.consensus
                                     .hardfork_switch
                                     .is_vm_version_1_and_syscalls_2_enabled(epoch)
                             };
+                            let fee_rate = FeeRate::calculate(
+                                verified.fee,
+                                orphan.tx.data().serialized_size_in_block(),
+                            );
                             self.remove_orphan_tx(&orphan.tx.proposal_short_id()).await;
-                            self.broadcast_tx(Some(orphan.peer), orphan.tx.hash(), with_vm_2021);
+                            self.broadcast_tx(
+                                Some(orphan.peer),
+                                orphan.tx.hash(),
+                                with_vm_2021,
+                                fee_rate,
+                            );
                             orphan_queue.push_back(orphan.tx);
                         }
                         Err(reject) => {
@@ -664,8 +820,12 @@ impl TxPoolService {
         origin: Option<PeerIndex>,
         tx_hash: Byte32,
         with_vm_2021: bool,
+        fee_rate: FeeRate,
     ) {
-        if let Err(e) = self.tx_relay_sender.send((origin, with_vm_2021, tx_hash)) {
+        if let Err(e) = self
+            .tx_relay_sender
+            .send((origin, with_vm_2021, tx_hash, fee_rate))
+        {
             error!("tx-pool broadcast_tx internal error {}", e);
         }
     }
@@ -779,8 +939,9 @@ impl TxPoolService {
             // update cache
             let txs_verify_cache = Arc::clone(&self.txs_verify_cache);
             tokio::spawn(async move {
-                let mut guard = txs_verify_cache.write().await;
-                guard.put(tx_hash, CacheEntry::Completed(completed));
+                txs_verify_cache
+                    .put(tx_hash, CacheEntry::Completed(completed))
+                    .await;
             });
         }
 
@@ -799,8 +960,7 @@ impl TxPoolService {
         let tx_hash = tx.hash();
         let mut chunk = self.chunk.write().await;
         if chunk.add_tx(tx) {
-            let mut guard = self.txs_verify_cache.write().await;
-            guard.put(tx_hash, cached);
+            self.txs_verify_cache.put(tx_hash, cached).await;
         }
         Ok(())
     }
@@ -819,24 +979,38 @@ impl TxPoolService {
             return Err(Reject::Duplicated(tx.hash()));
         }
 
+        let timer = Timer::start();
         let (tip_hash, snapshot, rtx, status, fee, tx_size) = self.pre_check(tx).await?;
+        metrics!(timing, "ckb.tx_stage.pre_check", timer.stop());
 
         let verify_cache = self.fetch_tx_verify_cache(&tx_hash).await;
         let max_cycles = max_cycles.unwrap_or_else(|| self.consensus.max_block_cycles());
         let tip_header = snapshot.tip_header();
         let tx_env = status.with_env(tip_header);
-        let verified = verify_rtx(&snapshot, &rtx, &tx_env, &verify_cache, max_cycles)?;
+        let timer = Timer::start();
+        let verified = verify_rtx(
+            &snapshot,
+            &rtx,
+            &tx_env,
+            &verify_cache,
+            max_cycles,
+            self.tx_pool_config.parallel_script_verify,
+        )?;
+        metrics!(timing, "ckb.tx_stage.verify", timer.stop());
 
         let entry = TxEntry::new(rtx, verified.cycles, fee, tx_size);
 
+        let timer = Timer::start();
         self.submit_entry(verified, tip_hash, entry, status).await?;
+        metrics!(timing, "ckb.tx_stage.submit", timer.stop());
 
         if verify_cache.is_none() {
             // update cache
             let txs_verify_cache = Arc::clone(&self.txs_verify_cache);
             tokio::spawn(async move {
-                let mut guard = txs_verify_cache.write().await;
-                guard.put(tx_hash, CacheEntry::Completed(verified));
+                txs_verify_cache
+                    .put(tx_hash, CacheEntry::Completed(verified))
+                    .await;
             });
         }
 
@@ -877,7 +1051,7 @@ impl TxPoolService {
                 let txs_opt = if hardfork_during_detach || hardfork_during_attach {
                     // The tx_pool is locked, remove all caches if has any hardfork.
                     {
-                        self.txs_verify_cache.write().await.clear();
+                        self.txs_verify_cache.clear().await;
                     }
                     {
                         self.chunk.write().await.clear();
@@ -946,9 +1120,14 @@ impl TxPoolService {
                     let snapshot = tx_pool.snapshot();
                     let tip_header = snapshot.tip_header();
                     let tx_env = status.with_env(tip_header);
-                    if let Ok(verified) =
-                        verify_rtx(snapshot, &rtx, &tx_env, &verify_cache, max_cycles)
-                    {
+                    if let Ok(verified) = verify_rtx(
+                        snapshot,
+                        &rtx,
+                        &tx_env,
+                        &verify_cache,
+                        max_cycles,
+                        self.tx_pool_config.parallel_script_verify,
+                    ) {
                         let entry = TxEntry::new(rtx, verified.cycles, fee, tx_size);
                         if let Err(e) = _submit_entry(tx_pool, status, entry, &self.callbacks) {
                             debug!("readd_dettached_tx submit_entry error {}", e);
@@ -979,8 +1158,14 @@ impl TxPoolService {
     pub(crate) async fn clear_pool(&mut self, new_snapshot: Arc<Snapshot>) {
         let mut tx_pool = self.tx_pool.write().await;
         let config = tx_pool.config;
+        let short_id_index = Arc::clone(&tx_pool.short_id_index);
         self.last_txs_updated_at = Arc::new(AtomicU64::new(0));
-        *tx_pool = TxPool::new(config, new_snapshot, Arc::clone(&self.last_txs_updated_at));
+        *tx_pool = TxPool::new(
+            config,
+            new_snapshot,
+            Arc::clone(&self.last_txs_updated_at),
+            short_id_index,
+        );
     }
 }
 
@@ -1122,31 +1307,28 @@ fn _update_tx_pool_for_reorg(
     // try move gap to proposed
     for entry in tx_pool.gap.entries() {
         if snapshot.proposals().contains_proposed(entry.key()) {
-            let tx_entry = entry.get();
+            let tx_entry = entry.remove();
             entries.push((
                 Some(CacheEntry::completed(tx_entry.cycles, tx_entry.fee)),
-                tx_entry.clone(),
+                tx_entry,
             ));
-            entry.remove();
         }
     }
 
     // try move pending to proposed
     for entry in tx_pool.pending.entries() {
         if snapshot.proposals().contains_proposed(entry.key()) {
-            let tx_entry = entry.get();
+            let tx_entry = entry.remove();
             entries.push((
                 Some(CacheEntry::completed(tx_entry.cycles, tx_entry.fee)),
-                tx_entry.clone(),
+                tx_entry,
             ));
-            entry.remove();
         } else if snapshot.proposals().contains_gap(entry.key()) {
-            let tx_entry = entry.get();
+            let tx_entry = entry.remove();
             gaps.push((
                 Some(CacheEntry::completed(tx_entry.cycles, tx_entry.fee)),
-                tx_entry.clone(),
+                tx_entry,
             ));
-            entry.remove();
         }
     }
 
@@ -19,11 +19,12 @@ use ckb_stop_handler::{SignalSender, StopHandler, WATCH_INIT};
 use ckb_types::{
     core::{
         tx_pool::{TxPoolEntryInfo, TxPoolIds},
-        BlockView, Cycle, TransactionView, UncleBlockView, Version,
+        BlockView, Cycle, FeeRate, TransactionView, UncleBlockView, Version,
     },
     packed::{Byte32, ProposalShortId},
 };
 use ckb_verification::cache::{Completed, TxVerificationCache};
+use dashmap::DashMap;
 use faketime::unix_time_as_millis;
 use std::collections::{HashMap, HashSet, VecDeque};
 use std::sync::{
@@ -104,17 +105,20 @@ pub(crate) enum Message {
 pub struct TxPoolController {
     sender: mpsc::Sender<Message>,
     reorg_sender: mpsc::Sender<Notify<ChainReorgArgs>>,
-    chunk_tx: ckb_channel::Sender<Command>,
+    chunk_txs: Vec<ckb_channel::Sender<Command>>,
     handle: Handle,
     stop: StopHandler<()>,
-    chunk_stop: StopHandler<Command>,
+    chunk_stops: Vec<StopHandler<Command>>,
     started: Arc<AtomicBool>,
+    short_id_index: Arc<DashMap<ProposalShortId, TransactionView>>,
 }
 
 impl Drop for TxPoolController {
     fn drop(&mut self) {
         if self.service_started() {
-            self.chunk_stop.try_send(Command::Stop);
+            for chunk_stop in &mut self.chunk_stops {
+                chunk_stop.try_send(Command::Stop);
+            }
             self.stop.try_send(());
         }
     }
@@ -326,6 +330,23 @@ impl TxPoolController {
             .map_err(Into::into)
     }
 
+    /// Return txs found in the pool's short-id index, looked up synchronously
+    /// without a service round trip. Unlike `fetch_txs` this does not consult
+    /// the recently-committed cache or the store, so callers needing those
+    /// should fall back to `fetch_txs` for the misses.
+    pub fn fetch_txs_sync(
+        &self,
+        short_ids: impl Iterator<Item = ProposalShortId>,
+    ) -> HashMap<ProposalShortId, TransactionView> {
+        short_ids
+            .filter_map(|short_id| {
+                self.short_id_index
+                    .get(&short_id)
+                    .map(|tx| (short_id, tx.clone()))
+            })
+            .collect()
+    }
+
     /// Return txs for network
     pub fn fetch_txs(
         &self,
@@ -412,20 +433,24 @@ impl TxPoolController {
             .map_err(Into::into)
     }
 
-    /// send suspend chunk process cmd
+    /// send suspend chunk process cmd to all verify workers
     pub fn suspend_chunk_process(&self) -> Result<(), AnyError> {
-        self.chunk_tx
-            .try_send(Command::Suspend)
-            .map_err(handle_send_cmd_error)
-            .map_err(Into::into)
+        for chunk_tx in &self.chunk_txs {
+            chunk_tx
+                .try_send(Command::Suspend)
+                .map_err(handle_send_cmd_error)?;
+        }
+        Ok(())
     }
 
-    /// send continue chunk process cmd
+    /// send continue chunk process cmd to all verify workers
     pub fn continue_chunk_process(&self) -> Result<(), AnyError> {
-        self.chunk_tx
-            .try_send(Command::Continue)
-            .map_err(handle_send_cmd_error)
-            .map_err(Into::into)
+        for chunk_tx in &self.chunk_txs {
+            chunk_tx
+                .try_send(Command::Continue)
+                .map_err(handle_send_cmd_error)?;
+        }
+        Ok(())
     }
 }
 
@@ -434,17 +459,18 @@ pub struct TxPoolServiceBuilder {
     pub(crate) tx_pool_config: TxPoolConfig,
     pub(crate) snapshot: Arc<Snapshot>,
     pub(crate) block_assembler: Option<BlockAssembler>,
-    pub(crate) txs_verify_cache: Arc<RwLock<TxVerificationCache>>,
+    pub(crate) txs_verify_cache: Arc<TxVerificationCache>,
     pub(crate) snapshot_mgr: Arc<SnapshotMgr>,
     pub(crate) callbacks: Callbacks,
     pub(crate) receiver: mpsc::Receiver<Message>,
     pub(crate) reorg_receiver: mpsc::Receiver<Notify<ChainReorgArgs>>,
     pub(crate) signal_receiver: watch::Receiver<u8>,
     pub(crate) handle: Handle,
-    pub(crate) tx_relay_sender: ckb_channel::Sender<(Option<PeerIndex>, bool, Byte32)>,
-    pub(crate) chunk_rx: ckb_channel::Receiver<Command>,
+    pub(crate) tx_relay_sender: ckb_channel::Sender<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
+    pub(crate) chunk_rxs: Vec<ckb_channel::Receiver<Command>>,
     pub(crate) chunk: Arc<RwLock<ChunkQueue>>,
     pub(crate) started: Arc<AtomicBool>,
+    pub(crate) short_id_index: Arc<DashMap<ProposalShortId, TransactionView>>,
 }
 
 impl TxPoolServiceBuilder {
@@ -453,17 +479,20 @@ impl TxPoolServiceBuilder {
         tx_pool_config: TxPoolConfig,
         snapshot: Arc<Snapshot>,
         block_assembler_config: Option<BlockAssemblerConfig>,
-        txs_verify_cache: Arc<RwLock<TxVerificationCache>>,
+        txs_verify_cache: Arc<TxVerificationCache>,
         snapshot_mgr: Arc<SnapshotMgr>,
         handle: &Handle,
-        tx_relay_sender: ckb_channel::Sender<(Option<PeerIndex>, bool, Byte32)>,
+        tx_relay_sender: ckb_channel::Sender<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
     ) -> (TxPoolServiceBuilder, TxPoolController) {
         let (sender, receiver) = mpsc::channel(DEFAULT_CHANNEL_SIZE);
         let (reorg_sender, reorg_receiver) = mpsc::channel(DEFAULT_CHANNEL_SIZE);
         let (signal_sender, signal_receiver) = watch::channel(WATCH_INIT);
-        let (chunk_tx, chunk_rx) = ckb_channel::bounded(12);
+        let (chunk_txs, chunk_rxs): (Vec<_>, Vec<_>) = (0..crate::chunk_process::CHUNK_VERIFY_WORKERS)
+            .map(|_| ckb_channel::bounded(12))
+            .unzip();
         let chunk = Arc::new(RwLock::new(ChunkQueue::new()));
         let started = Arc::new(AtomicBool::new(false));
+        let short_id_index = Arc::new(DashMap::new());
 
         let builder = TxPoolServiceBuilder {
             tx_pool_config,
@@ -477,21 +506,26 @@ impl TxPoolServiceBuilder {
             signal_receiver,
             handle: handle.clone(),
             tx_relay_sender,
-            chunk_rx,
+            chunk_rxs,
             chunk,
             started: Arc::clone(&started),
+            short_id_index: Arc::clone(&short_id_index),
         };
 
         let stop = StopHandler::new(SignalSender::Watch(signal_sender), None);
-        let chunk_stop = StopHandler::new(SignalSender::Crossbeam(chunk_tx.clone()), None);
+        let chunk_stops = chunk_txs
+            .iter()
+            .map(|chunk_tx| StopHandler::new(SignalSender::Crossbeam(chunk_tx.clone()), None))
+            .collect();
         let controller = TxPoolController {
             sender,
             reorg_sender,
             handle: handle.clone(),
-            chunk_stop,
-            chunk_tx,
+            chunk_stops,
+            chunk_txs,
             stop,
             started,
+            short_id_index,
         };
         (builder, controller)
     }
@@ -524,6 +558,7 @@ impl TxPoolServiceBuilder {
             self.tx_pool_config,
             self.snapshot,
             Arc::clone(&last_txs_updated_at),
+            Arc::clone(&self.short_id_index),
         );
 
         let service = TxPoolService {
@@ -541,13 +576,15 @@ impl TxPoolServiceBuilder {
             last_txs_updated_at,
         };
 
-        let mut chunk_process = crate::chunk_process::TxChunkProcess::new(
-            service.clone(),
-            self.handle.clone(),
-            self.chunk_rx,
-        );
+        for chunk_rx in self.chunk_rxs {
+            let mut chunk_process = crate::chunk_process::TxChunkProcess::new(
+                service.clone(),
+                self.handle.clone(),
+                chunk_rx,
+            );
 
-        self.handle.spawn_blocking(move || chunk_process.run());
+            self.handle.spawn_blocking(move || chunk_process.run());
+        }
 
         let mut receiver = self.receiver;
         let mut reorg_receiver = self.reorg_receiver;
@@ -603,12 +640,12 @@ pub(crate) struct TxPoolService {
     pub(crate) consensus: Arc<Consensus>,
     pub(crate) tx_pool_config: Arc<TxPoolConfig>,
     pub(crate) block_assembler: Option<BlockAssembler>,
-    pub(crate) txs_verify_cache: Arc<RwLock<TxVerificationCache>>,
+    pub(crate) txs_verify_cache: Arc<TxVerificationCache>,
     pub(crate) last_txs_updated_at: Arc<AtomicU64>,
     pub(crate) callbacks: Arc<Callbacks>,
     pub(crate) snapshot_mgr: Arc<SnapshotMgr>,
     pub(crate) network: NetworkController,
-    pub(crate) tx_relay_sender: ckb_channel::Sender<(Option<PeerIndex>, bool, Byte32)>,
+    pub(crate) tx_relay_sender: ckb_channel::Sender<(Option<PeerIndex>, bool, Byte32, FeeRate)>,
     pub(crate) chunk: Arc<RwLock<ChunkQueue>>,
 }
 
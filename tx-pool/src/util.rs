@@ -78,6 +78,7 @@ pub(crate) fn verify_rtx(
     tx_env: &TxVerifyEnv,
     cache_entry: &Option<CacheEntry>,
     max_tx_verify_cycles: Cycle,
+    parallel_script_verify: bool,
 ) -> Result<Completed, Reject> {
     let consensus = snapshot.consensus();
 
@@ -100,13 +101,14 @@ pub(crate) fn verify_rtx(
         }
     } else {
         block_in_place(|| {
-            ContextualTransactionVerifier::new(
-                &rtx,
-                consensus,
-                &snapshot.as_data_provider(),
-                tx_env,
-            )
-            .verify(max_tx_verify_cycles, false)
+            let data_provider = snapshot.as_data_provider();
+            let verifier =
+                ContextualTransactionVerifier::new(&rtx, consensus, &data_provider, tx_env);
+            if parallel_script_verify {
+                verifier.verify_parallel(max_tx_verify_cycles)
+            } else {
+                verifier.verify(max_tx_verify_cycles, false)
+            }
             .map_err(Reject::Verification)
         })
     }
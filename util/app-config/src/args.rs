@@ -15,6 +15,8 @@ pub struct ExportArgs {
     pub consensus: Consensus,
     /// The target directory to save the exported file.
     pub target: PathBuf,
+    /// Exports the live cell set snapshot instead of the block data.
+    pub cell_set: bool,
 }
 
 /// Parsed command line arguments for `ckb import`.
@@ -25,6 +27,8 @@ pub struct ImportArgs {
     pub consensus: Consensus,
     /// The path to the file to be imported.
     pub source: PathBuf,
+    /// Imports a live cell set snapshot instead of the block data.
+    pub cell_set: bool,
 }
 
 /// Parsed command line arguments for `ckb run`.
@@ -42,6 +42,8 @@ pub const ARG_TARGET: &str = "target";
 pub const ARG_SOURCE: &str = "source";
 /// Command line argument `--data`.
 pub const ARG_DATA: &str = "data";
+/// Command line argument `--cell-set`.
+pub const ARG_CELL_SET: &str = "cell-set";
 /// Command line argument `--list-chains`.
 pub const ARG_LIST_CHAINS: &str = "list-chains";
 /// Command line argument `--interactive`.
@@ -311,6 +313,10 @@ fn export() -> App<'static, 'static> {
                 .index(1)
                 .help("Specifies the export target path."),
         )
+        .arg(Arg::with_name(ARG_CELL_SET).long(ARG_CELL_SET).help(
+            "Exports the live cell set as a chunked, hash-committed snapshot \
+             instead of the block data.",
+        ))
 }
 
 fn import() -> App<'static, 'static> {
@@ -325,6 +331,10 @@ fn import() -> App<'static, 'static> {
                 .index(1)
                 .help("Specifies the exported data path."),
         )
+        .arg(Arg::with_name(ARG_CELL_SET).long(ARG_CELL_SET).help(
+            "Imports a chunked cell-set snapshot written by `ckb export --cell-set` \
+             instead of the block data.",
+        ))
 }
 
 fn migrate() -> App<'static, 'static> {
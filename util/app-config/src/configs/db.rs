@@ -23,6 +23,10 @@ pub struct Config {
     ///
     /// More details can be found in [the official tuning guide](https://github.com/facebook/rocksdb/wiki/RocksDB-Tuning-Guide).
     pub options_file: Option<PathBuf>,
+    /// Enable RocksDB pipelined writes, overlapping WAL and memtable writes
+    /// from the commit path, default is false.
+    #[serde(default)]
+    pub pipelined_write: bool,
 }
 
 impl Config {
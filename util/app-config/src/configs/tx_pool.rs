@@ -18,6 +18,8 @@ pub struct TxPoolConfig {
     pub max_tx_verify_cycles: Cycle,
     /// max ancestors size limit for a single tx
     pub max_ancestors_count: usize,
+    /// run independent script groups of one transaction in parallel
+    pub parallel_script_verify: bool,
 }
 
 /// Block assembler config options.
@@ -22,6 +22,8 @@ pub(crate) struct TxPoolConfig {
     min_fee_rate: FeeRate,
     max_tx_verify_cycles: Cycle,
     max_ancestors_count: usize,
+    #[serde(default)]
+    parallel_script_verify: bool,
 }
 
 impl Default for crate::TxPoolConfig {
@@ -41,6 +43,7 @@ impl Default for TxPoolConfig {
             min_fee_rate: DEFAULT_MIN_FEE_RATE,
             max_tx_verify_cycles: DEFAULT_MAX_TX_VERIFY_CYCLES,
             max_ancestors_count: DEFAULT_MAX_ANCESTORS_COUNT,
+            parallel_script_verify: false,
         }
     }
 }
@@ -56,6 +59,7 @@ impl From<TxPoolConfig> for crate::TxPoolConfig {
             min_fee_rate,
             max_tx_verify_cycles,
             max_ancestors_count,
+            parallel_script_verify,
         } = input;
         Self {
             max_mem_size,
@@ -63,6 +67,7 @@ impl From<TxPoolConfig> for crate::TxPoolConfig {
             min_fee_rate,
             max_tx_verify_cycles,
             max_ancestors_count,
+            parallel_script_verify,
         }
     }
 }
@@ -188,11 +188,13 @@ impl Setup {
         let consensus = self.consensus()?;
         let config = self.config.into_ckb()?;
         let source = value_t!(matches.value_of(cli::ARG_SOURCE), PathBuf)?;
+        let cell_set = matches.is_present(cli::ARG_CELL_SET);
 
         Ok(ImportArgs {
             config,
             consensus,
             source,
+            cell_set,
         })
     }
 
@@ -201,11 +203,13 @@ impl Setup {
         let consensus = self.consensus()?;
         let config = self.config.into_ckb()?;
         let target = value_t!(matches.value_of(cli::ARG_TARGET), PathBuf)?;
+        let cell_set = matches.is_present(cli::ARG_CELL_SET);
 
         Ok(ExportArgs {
             config,
             consensus,
             target,
+            cell_set,
         })
     }
 
@@ -1,23 +1,29 @@
 //! TODO(doc): @quake
 use ckb_store::ChainStore;
 use ckb_types::{core::BlockNumber, core::BlockView};
+use std::collections::VecDeque;
+
+/// Number of blocks fetched from the store per batched range read.
+const BATCH_SIZE: u64 = 32;
 
 /// TODO(doc): @quake
 // An iterator over the entries of a `Chain`.
 pub struct ChainIterator<'a, S: ChainStore<'a>> {
     store: &'a S,
-    current: Option<BlockView>,
+    // blocks fetched ahead through the store's batched range reads
+    buffer: VecDeque<BlockView>,
+    next_number: BlockNumber,
     tip: BlockNumber,
 }
 
 impl<'a, S: ChainStore<'a>> ChainIterator<'a, S> {
     /// TODO(doc): @quake
     pub fn new(store: &'a S) -> Self {
-        let current = store.get_block_hash(0).and_then(|h| store.get_block(&h));
         let tip = store.get_tip_header().expect("store inited").number();
         ChainIterator {
             store,
-            current,
+            buffer: VecDeque::new(),
+            next_number: 0,
             tip,
         }
     }
@@ -39,26 +45,29 @@ impl<'a, S: ChainStore<'a>> Iterator for ChainIterator<'a, S> {
     type Item = BlockView;
 
     fn next(&mut self) -> Option<Self::Item> {
-        let current = self.current.take();
-
-        self.current = match current {
-            Some(ref b) => {
-                if let Some(block_hash) = self.store.get_block_hash(b.header().number() + 1) {
-                    self.store.get_block(&block_hash)
-                } else {
-                    None
-                }
+        if self.buffer.is_empty() && self.next_number <= self.tip {
+            self.buffer.extend(
+                self.store
+                    .get_blocks_in_range(self.next_number, BATCH_SIZE),
+            );
+            if self.buffer.is_empty() {
+                // missing block cuts the iteration short
+                self.next_number = self.tip + 1;
+            } else {
+                self.next_number += self.buffer.len() as u64;
             }
-            None => None,
-        };
-        current
+        }
+        self.buffer.pop_front()
     }
 
     fn size_hint(&self) -> (usize, Option<usize>) {
-        match self.current {
-            Some(ref b) => (1, Some((self.tip - b.header().number() + 1) as usize)),
-            //The default implementation returns (0, None) which is correct for any iterator.
-            None => (0, None),
+        let remain = (self.tip + 1)
+            .saturating_sub(self.next_number)
+            .saturating_add(self.buffer.len() as u64) as usize;
+        if remain == 0 {
+            (0, None)
+        } else {
+            (1, Some(remain))
         }
     }
 }
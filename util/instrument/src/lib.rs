@@ -4,10 +4,14 @@
 //!
 //! - [`Export`] provides block data export function.
 //! - [`Import`] imports block data which export from `Export`.
+//! - [`CellSetSnapshotExport`] and [`CellSetSnapshotImport`] move the live
+//!   cell set as a chunked, hash-committed snapshot.
 
+mod cell_set;
 mod export;
 mod import;
 
+pub use crate::cell_set::{CellSetManifest, CellSetSnapshotExport, CellSetSnapshotImport};
 pub use crate::export::Export;
 pub use crate::import::Import;
 #[cfg(feature = "progress_bar")]
@@ -21,8 +21,9 @@ use ckb_snapshot::{Snapshot, SnapshotMgr};
 use ckb_stop_handler::StopHandler;
 use ckb_store::ChainDB;
 use ckb_store::ChainStore;
-use ckb_tx_pool::{error::Reject, TokioRwLock, TxEntry, TxPool, TxPoolServiceBuilder};
+use ckb_tx_pool::{error::Reject, TxEntry, TxPool, TxPoolServiceBuilder};
 use ckb_types::core::EpochExt;
+use ckb_types::core::FeeRate;
 use ckb_types::core::HeaderView;
 use ckb_types::packed::Byte32;
 use ckb_verification::cache::init_cache;
@@ -35,6 +36,7 @@ use std::sync::Arc;
 /// Shared builder for construct new shared.
 pub struct SharedBuilder {
     db: RocksDB,
+    db_path: Option<PathBuf>,
     ancient_path: Option<PathBuf>,
     consensus: Option<Consensus>,
     tx_pool_config: Option<TxPoolConfig>,
@@ -94,6 +96,7 @@ impl SharedBuilder {
 
         Ok(SharedBuilder {
             db,
+            db_path: Some(db_config.path.clone()),
             ancient_path: ancient,
             consensus: None,
             tx_pool_config: None,
@@ -119,6 +122,7 @@ impl SharedBuilder {
 
         RUNTIME_HANDLE.with(|runtime| SharedBuilder {
             db: RocksDB::open_tmp(COLUMNS),
+            db_path: None,
             ancient_path: None,
             consensus: None,
             tx_pool_config: None,
@@ -254,6 +258,7 @@ impl SharedBuilder {
     pub fn build(self) -> Result<(Shared, SharedPackage), ExitCode> {
         let SharedBuilder {
             db,
+            db_path,
             ancient_path,
             consensus,
             tx_pool_config,
@@ -274,8 +279,12 @@ impl SharedBuilder {
             eprintln!("build_store {}", e);
             ExitCode::Failure
         })?;
+        let store = match db_path {
+            Some(path) => store.with_cell_data_cache_file(path.join("cell-data-cache")),
+            None => store,
+        };
 
-        let txs_verify_cache = Arc::new(TokioRwLock::new(init_cache()));
+        let txs_verify_cache = Arc::new(init_cache());
 
         let (snapshot, table) =
             Self::init_snapshot(&store, Arc::clone(&consensus)).map_err(|e| {
@@ -327,7 +336,7 @@ impl SharedBuilder {
 pub struct SharedPackage {
     table: Option<ProposalTable>,
     tx_pool_builder: Option<TxPoolServiceBuilder>,
-    relay_tx_receiver: Option<Receiver<(Option<PeerIndex>, bool, Byte32)>>,
+    relay_tx_receiver: Option<Receiver<(Option<PeerIndex>, bool, Byte32, FeeRate)>>,
 }
 
 impl SharedPackage {
@@ -342,7 +351,7 @@ impl SharedPackage {
     }
 
     /// Takes the relay_tx_receiver out of the package, leaving a None in its place.
-    pub fn take_relay_tx_receiver(&mut self) -> Receiver<(Option<PeerIndex>, bool, Byte32)> {
+    pub fn take_relay_tx_receiver(&mut self) -> Receiver<(Option<PeerIndex>, bool, Byte32, FeeRate)> {
         self.relay_tx_receiver
             .take()
             .expect("take relay_tx_receiver")
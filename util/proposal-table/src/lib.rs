@@ -109,33 +109,31 @@ impl ProposalTable {
         //      new_ids = [candidate_number- farthest..= candidate_number- closest]
         //      gap = [candidate_number- closest + 1..candidate_number]
         // - end
+        // union the window ranges element-wise; cloning the per-block sets
+        // before flattening costs one allocation per block per finalize,
+        // which dominates at large pool sizes
+        let union_range = |range: (Bound<&BlockNumber>, Bound<&BlockNumber>)| {
+            let mut union: HashSet<ProposalShortId> = HashSet::with_capacity(
+                self.table.range(range).map(|(_, ids)| ids.len()).sum(),
+            );
+            for (_, ids) in self.table.range(range) {
+                union.extend(ids.iter().cloned());
+            }
+            union
+        };
+
         let (new_ids, gap) = if candidate_number <= self.proposal_window.closest() {
             (
                 HashSet::new(),
-                self.table
-                    .range((Bound::Unbounded, Bound::Included(&number)))
-                    .map(|pair| pair.1)
-                    .cloned()
-                    .flatten()
-                    .collect(),
+                union_range((Bound::Unbounded, Bound::Included(&number))),
             )
         } else {
             (
-                self.table
-                    .range((
-                        Bound::Included(&proposal_start),
-                        Bound::Included(&proposal_end),
-                    ))
-                    .map(|pair| pair.1)
-                    .cloned()
-                    .flatten()
-                    .collect(),
-                self.table
-                    .range((Bound::Excluded(&proposal_end), Bound::Included(&number)))
-                    .map(|pair| pair.1)
-                    .cloned()
-                    .flatten()
-                    .collect(),
+                union_range((
+                    Bound::Included(&proposal_start),
+                    Bound::Included(&proposal_end),
+                )),
+                union_range((Bound::Excluded(&proposal_end), Bound::Included(&number))),
             )
         };
 
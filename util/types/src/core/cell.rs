@@ -562,6 +562,39 @@ impl<'a> CellProvider for TransactionsProvider<'a> {
     }
 }
 
+/// Serves cells out of a map of pre-materialized `CellMeta`s, falling back
+/// to the underlying provider for anything absent from the map or for
+/// eager-load requests (the prefetch does not carry cell data).
+///
+/// Only live cells may be prefetched; dead or unknown out points must be
+/// left out of the map so the underlying provider stays authoritative for
+/// them.
+pub struct PrefetchedCellProvider<'a, CP> {
+    cells: HashMap<OutPoint, CellMeta>,
+    cell_provider: &'a CP,
+}
+
+impl<'a, CP: CellProvider> PrefetchedCellProvider<'a, CP> {
+    /// Construct new PrefetchedCellProvider
+    pub fn new(cells: HashMap<OutPoint, CellMeta>, cell_provider: &'a CP) -> Self {
+        Self {
+            cells,
+            cell_provider,
+        }
+    }
+}
+
+impl<'a, CP: CellProvider> CellProvider for PrefetchedCellProvider<'a, CP> {
+    fn cell(&self, out_point: &OutPoint, eager_load: bool) -> CellStatus {
+        if !eager_load {
+            if let Some(cell_meta) = self.cells.get(out_point) {
+                return CellStatus::live_cell(cell_meta.clone());
+            }
+        }
+        self.cell_provider.cell(out_point, eager_load)
+    }
+}
+
 /// TODO(doc): @quake
 pub trait HeaderChecker {
     /// Check if header in main chain
@@ -611,6 +644,44 @@ pub fn get_related_dep_out_points<F: Fn(&OutPoint) -> Option<Bytes>>(
     )
 }
 
+/// Gather the distinct out points that a block's transactions read from the
+/// underlying store: every input and cell dep out point except those created
+/// by the block's own transactions (resolved in-memory by
+/// `BlockCellProvider`) and cell deps served by the system cell cache.
+/// Dep group out points are not included (their header cells are resolved
+/// with `eager_load`, which a data-less prefetch cannot serve), and neither
+/// are their sub out points, since discovering those requires reading the
+/// dep group cell data first.
+pub fn gather_block_referenced_out_points(block: &BlockView) -> Vec<OutPoint> {
+    let in_block: HashSet<Byte32> = block.transactions().iter().map(|tx| tx.hash()).collect();
+    let system_cell = SYSTEM_CELL.get();
+    let mut seen: HashSet<OutPoint> = HashSet::new();
+    let mut out_points = Vec::new();
+    for tx in block.transactions().iter() {
+        if !tx.is_cellbase() {
+            for out_point in tx.input_pts_iter() {
+                if !in_block.contains(&out_point.tx_hash()) && seen.insert(out_point.clone()) {
+                    out_points.push(out_point);
+                }
+            }
+        }
+        for cell_dep in tx.cell_deps_iter() {
+            if cell_dep.dep_type() == DepType::DepGroup.into()
+                || system_cell
+                    .map(|cache| cache.contains_key(&cell_dep))
+                    .unwrap_or(false)
+            {
+                continue;
+            }
+            let out_point = cell_dep.out_point();
+            if !in_block.contains(&out_point.tx_hash()) && seen.insert(out_point.clone()) {
+                out_points.push(out_point);
+            }
+        }
+    }
+    out_points
+}
+
 fn parse_dep_group_data(slice: &[u8]) -> Result<OutPointVec, String> {
     if slice.is_empty() {
         Err("data is empty".to_owned())
@@ -1292,4 +1363,58 @@ mod tests {
             assert_error_eq!(result2.unwrap_err(), OutPointError::Dead(out_point));
         }
     }
+
+    #[test]
+    fn prefetched_cell_provider_serves_live_cells_and_falls_back() {
+        let mut db = CellMemoryDb::default();
+        let p1 = OutPoint::new(Byte32::zero(), 1);
+        let p2 = OutPoint::new(Byte32::zero(), 2);
+        let p3 = OutPoint::new(Byte32::zero(), 3);
+        let p4 = OutPoint::new(Byte32::zero(), 4);
+        db.cells.insert(p2.clone(), None);
+
+        let prefetched_meta = generate_dummy_cell_meta_with_out_point(p1.clone());
+        let mut prefetched = HashMap::new();
+        prefetched.insert(p1.clone(), prefetched_meta.clone());
+        let provider = PrefetchedCellProvider::new(prefetched, &db);
+
+        // prefetched live cells are served from the map
+        assert_eq!(
+            CellStatus::live_cell(prefetched_meta),
+            provider.cell(&p1, false)
+        );
+        // everything absent from the map is answered by the inner provider
+        assert_eq!(CellStatus::Dead, provider.cell(&p2, false));
+        assert_eq!(CellStatus::Unknown, provider.cell(&p3, false));
+        // eager-load requests bypass the map, the prefetch carries no data
+        assert_eq!(CellStatus::Unknown, provider.cell(&p1, true));
+        assert_eq!(CellStatus::Unknown, provider.cell(&p4, false));
+    }
+
+    #[test]
+    fn gather_block_referenced_out_points_dedups_and_skips_in_block() {
+        let op1 = OutPoint::new(h256!("0x1").pack(), 0);
+        let op2 = OutPoint::new(h256!("0x2").pack(), 0);
+
+        let cellbase = TransactionBuilder::default()
+            .input(CellInput::new(OutPoint::null(), 0))
+            .witness(Default::default())
+            .build();
+        let tx_a = TransactionBuilder::default()
+            .input(CellInput::new(op1.clone(), 0))
+            .cell_dep(CellDep::new_builder().out_point(op2.clone()).build())
+            .build();
+        // spends an output created by tx_a (resolved in-block) and repeats
+        // the dep of tx_a
+        let tx_b = TransactionBuilder::default()
+            .input(CellInput::new(OutPoint::new(tx_a.hash(), 0), 0))
+            .cell_dep(CellDep::new_builder().out_point(op2.clone()).build())
+            .build();
+        let block = generate_block(vec![cellbase, tx_a, tx_b]);
+
+        assert_eq!(
+            vec![op1, op2],
+            gather_block_referenced_out_points(&block)
+        );
+    }
 }
@@ -6,6 +6,7 @@ use ckb_error::Error;
 use ckb_logger::error_target;
 use ckb_metrics::{metrics, Timer};
 use ckb_reward_calculator::RewardCalculator;
+use ckb_script::{extract_sighash_all_entries, SighashAllEntry};
 use ckb_store::ChainStore;
 use ckb_traits::HeaderProvider;
 use ckb_types::{
@@ -29,7 +30,7 @@ use ckb_verification_traits::Switch;
 use rayon::iter::{IndexedParallelIterator, IntoParallelRefIterator, ParallelIterator};
 use std::collections::{HashMap, HashSet};
 use std::sync::Arc;
-use tokio::sync::{oneshot, RwLock};
+use tokio::sync::oneshot;
 
 /// Context for context-dependent block verification
 pub struct VerifyContext<'a, CS> {
@@ -312,6 +313,70 @@ impl<'a, 'b, 'c, CS: ChainStore<'a>> DaoHeaderVerifier<'a, 'b, 'c, CS> {
     }
 }
 
+/// Batch-checks the signatures of recognized secp256k1_blake160_sighash_all
+/// lock groups natively when full script verification is skipped (assume-valid
+/// sync below the trusted target), at a small fraction of the VM cost.
+/// Unrecognized groups stay skipped as before; any native mismatch falls back
+/// to the VM for the authoritative verdict, so the native engine can never
+/// reject a block the VM would accept.
+struct RecognizedSignaturesVerifier<'a, CS> {
+    context: &'a VerifyContext<'a, CS>,
+    header: HeaderView,
+    resolved: &'a [ResolvedTransaction],
+}
+
+impl<'a, CS: ChainStore<'a>> RecognizedSignaturesVerifier<'a, CS> {
+    pub fn new(
+        context: &'a VerifyContext<'a, CS>,
+        header: HeaderView,
+        resolved: &'a [ResolvedTransaction],
+    ) -> Self {
+        RecognizedSignaturesVerifier {
+            context,
+            header,
+            resolved,
+        }
+    }
+
+    pub fn verify(&self) -> Result<(), Error> {
+        let timer = Timer::start();
+        let consensus = self.context.consensus;
+        let mismatched: Vec<u32> = self
+            .resolved
+            .par_iter()
+            .enumerate()
+            .skip(1)
+            .filter_map(|(index, tx)| {
+                let entries = extract_sighash_all_entries(tx, consensus);
+                if entries.iter().all(SighashAllEntry::verify) {
+                    None
+                } else {
+                    Some(index as u32)
+                }
+            })
+            .collect();
+
+        for index in mismatched {
+            let tx = &self.resolved[index as usize];
+            let tx_env = TxVerifyEnv::new_commit(&self.header);
+            ContextualTransactionVerifier::new(
+                tx,
+                consensus,
+                &self.context.store.as_data_provider(),
+                &tx_env,
+            )
+            .verify(consensus.max_block_cycles(), false)
+            .map_err(|error| BlockTransactionsError { index, error })?;
+        }
+        metrics!(
+            timing,
+            "ckb.recognized_signatures_verified_block",
+            timer.stop()
+        );
+        Ok(())
+    }
+}
+
 struct BlockTxsVerifier<'a, CS> {
     context: &'a VerifyContext<'a, CS>,
     header: HeaderView,
@@ -333,17 +398,13 @@ impl<'a, CS: ChainStore<'a>> BlockTxsVerifier<'a, CS> {
 
     fn fetched_cache<K: IntoIterator<Item = Byte32> + Send + 'static>(
         &self,
-        txs_verify_cache: Arc<RwLock<TxVerificationCache>>,
+        txs_verify_cache: Arc<TxVerificationCache>,
         keys: K,
         handle: &Handle,
     ) -> HashMap<Byte32, CacheEntry> {
         let (sender, receiver) = oneshot::channel();
         handle.spawn(async move {
-            let guard = txs_verify_cache.read().await;
-            let ret = keys
-                .into_iter()
-                .filter_map(|hash| guard.peek(&hash).cloned().map(|value| (hash, value)))
-                .collect();
+            let ret = txs_verify_cache.fetch(keys.into_iter().collect()).await;
 
             if let Err(e) = sender.send(ret) {
                 error_target!(crate::LOG_TARGET, "TxsVerifier fetched_cache error {:?}", e);
@@ -356,7 +417,7 @@ impl<'a, CS: ChainStore<'a>> BlockTxsVerifier<'a, CS> {
 
     pub fn verify(
         &self,
-        txs_verify_cache: Arc<RwLock<TxVerificationCache>>,
+        txs_verify_cache: Arc<TxVerificationCache>,
         handle: &Handle,
         skip_script_verify: bool,
     ) -> Result<(Cycle, Vec<Completed>), Error> {
@@ -376,12 +437,23 @@ impl<'a, CS: ChainStore<'a>> BlockTxsVerifier<'a, CS> {
             HashMap::new()
         };
 
-        // make verifiers orthogonal
-        let ret = self
-            .resolved
+        // Schedule full verifications before cache hits: the verifiers are
+        // orthogonal so the pool runs them concurrently, and starting the
+        // expensive cache-miss transactions first leaves only cheap cache
+        // replays as stragglers at the end of the block.
+        let mut order: Vec<usize> = (1..self.resolved.len()).collect();
+        order.sort_by_key(|index| {
+            match fetched_cache.get(&self.resolved[*index].transaction.hash()) {
+                None => 0,
+                Some(CacheEntry::Suspended(_)) => 1,
+                Some(CacheEntry::Completed(_)) => 2,
+            }
+        });
+
+        let mut ret = order
             .par_iter()
-            .enumerate()
-            .map(|(index, tx)| {
+            .map(|&index| {
+                let tx = &self.resolved[index];
                 let tx_hash = tx.transaction.hash();
                 let tx_env = TxVerifyEnv::new_commit(&self.header);
                 if let Some(cache_entry) = fetched_cache.get(&tx_hash) {
@@ -400,7 +472,7 @@ impl<'a, CS: ChainStore<'a>> BlockTxsVerifier<'a, CS> {
                             }
                             .into()
                         })
-                        .map(|_| (tx_hash, *completed)),
+                        .map(|_| (index, tx_hash, *completed)),
                         CacheEntry::Suspended(suspended) => ContextualTransactionVerifier::new(
                             &tx,
                             self.context.consensus,
@@ -419,7 +491,7 @@ impl<'a, CS: ChainStore<'a>> BlockTxsVerifier<'a, CS> {
                             }
                             .into()
                         })
-                        .map(|completed| (tx_hash, completed)),
+                        .map(|completed| (index, tx_hash, completed)),
                     }
                 } else {
                     ContextualTransactionVerifier::new(
@@ -439,24 +511,28 @@ impl<'a, CS: ChainStore<'a>> BlockTxsVerifier<'a, CS> {
                         }
                         .into()
                     })
-                    .map(|completed| (tx_hash, completed))
+                    .map(|completed| (index, tx_hash, completed))
                 }
             })
-            .skip(1)
-            .collect::<Result<Vec<(Byte32, Completed)>, Error>>()?;
+            .collect::<Result<Vec<(usize, Byte32, Completed)>, Error>>()?;
+        // restore transaction order, fees and cache entries are positional
+        ret.sort_unstable_by_key(|(index, _, _)| *index);
 
-        let sum: Cycle = ret.iter().map(|(_, cache_entry)| cache_entry.cycles).sum();
+        let sum: Cycle = ret.iter().map(|(_, _, cache_entry)| cache_entry.cycles).sum();
         let cache_entires = ret
             .iter()
-            .map(|(_, completed)| completed)
+            .map(|(_, _, completed)| completed)
             .cloned()
             .collect();
         if !ret.is_empty() {
             handle.spawn(async move {
-                let mut guard = txs_verify_cache.write().await;
-                for (k, v) in ret {
-                    guard.put(k, CacheEntry::Completed(v));
-                }
+                txs_verify_cache
+                    .put_many(
+                        ret.into_iter()
+                            .map(|(_, k, v)| (k, CacheEntry::Completed(v)))
+                            .collect(),
+                    )
+                    .await;
             });
         }
 
@@ -529,7 +605,7 @@ impl<'a, CS: ChainStore<'a>> ContextualBlockVerifier<'a, CS> {
         &'a self,
         resolved: &'a [ResolvedTransaction],
         block: &'a BlockView,
-        txs_verify_cache: Arc<RwLock<TxVerificationCache>>,
+        txs_verify_cache: Arc<TxVerificationCache>,
         handle: &Handle,
         switch: Switch,
     ) -> Result<(Cycle, Vec<Completed>), Error> {
@@ -577,6 +653,10 @@ impl<'a, CS: ChainStore<'a>> ContextualBlockVerifier<'a, CS> {
             RewardVerifier::new(&self.context, resolved, &parent).verify()?;
         }
 
+        if switch.disable_script() && !switch.disable_all() {
+            RecognizedSignaturesVerifier::new(&self.context, header.clone(), resolved).verify()?;
+        }
+
         let ret = BlockTxsVerifier::new(&self.context, header, resolved).verify(
             txs_verify_cache,
             handle,
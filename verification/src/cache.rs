@@ -1,20 +1,121 @@
 //! TX verification cache
 
+use ckb_metrics::metrics;
 use ckb_script::TransactionSnapshot;
 use ckb_types::{
     core::{Capacity, Cycle},
     packed::Byte32,
+    prelude::*,
 };
+use std::collections::HashMap;
 use std::sync::Arc;
-
-/// TX verification lru cache
-pub type TxVerificationCache = lru::LruCache<Byte32, CacheEntry>;
+use tokio::sync::RwLock;
 
 const CACHE_SIZE: usize = 1000 * 30;
+// must be a power of two
+const SHARD_COUNT: usize = 16;
+
+/// TX verification lru cache.
+///
+/// The cache is sharded by tx-hash prefix, each shard behind its own lock, so
+/// concurrent `Completed` lookups from tx-pool workers and the relayer do not
+/// serialize on a single lock.
+pub struct TxVerificationCache {
+    shards: Vec<RwLock<lru::LruCache<Byte32, CacheEntry>>>,
+}
+
+impl Default for TxVerificationCache {
+    fn default() -> Self {
+        let shards = (0..SHARD_COUNT)
+            .map(|_| RwLock::new(lru::LruCache::new(CACHE_SIZE / SHARD_COUNT)))
+            .collect();
+        TxVerificationCache { shards }
+    }
+}
+
+impl TxVerificationCache {
+    // tx hashes are uniformly distributed, any byte works as the shard key
+    fn shard(&self, key: &Byte32) -> &RwLock<lru::LruCache<Byte32, CacheEntry>> {
+        let prefix = key.as_slice()[0] as usize;
+        &self.shards[prefix & (SHARD_COUNT - 1)]
+    }
+
+    /// Looks up a single entry without refreshing its recency.
+    pub async fn get(&self, key: &Byte32) -> Option<CacheEntry> {
+        let ret = self.shard(key).read().await.peek(key).cloned();
+        if ret.is_some() {
+            metrics!(counter, "ckb.tx_verify_cache.hit", 1);
+        } else {
+            metrics!(counter, "ckb.tx_verify_cache.miss", 1);
+        }
+        ret
+    }
+
+    /// Looks up a batch of entries, locking each shard at most once.
+    pub async fn fetch(&self, keys: Vec<Byte32>) -> HashMap<Byte32, CacheEntry> {
+        let total = keys.len();
+        let mut by_shard: Vec<Vec<Byte32>> = vec![Vec::new(); SHARD_COUNT];
+        for key in keys {
+            let prefix = key.as_slice()[0] as usize;
+            by_shard[prefix & (SHARD_COUNT - 1)].push(key);
+        }
+
+        let mut ret = HashMap::with_capacity(total);
+        for (shard, keys) in self.shards.iter().zip(by_shard) {
+            if keys.is_empty() {
+                continue;
+            }
+            let guard = shard.read().await;
+            for key in keys {
+                if let Some(value) = guard.peek(&key) {
+                    ret.insert(key, value.clone());
+                }
+            }
+        }
+        metrics!(counter, "ckb.tx_verify_cache.hit", ret.len() as u64);
+        metrics!(
+            counter,
+            "ckb.tx_verify_cache.miss",
+            (total - ret.len()) as u64
+        );
+        ret
+    }
+
+    /// Inserts a single entry.
+    pub async fn put(&self, key: Byte32, entry: CacheEntry) {
+        self.shard(&key).write().await.put(key, entry);
+    }
+
+    /// Inserts a batch of entries, locking each shard at most once.
+    pub async fn put_many(&self, entries: Vec<(Byte32, CacheEntry)>) {
+        let mut by_shard: Vec<Vec<(Byte32, CacheEntry)>> = vec![Vec::new(); SHARD_COUNT];
+        for (key, entry) in entries {
+            let prefix = key.as_slice()[0] as usize;
+            by_shard[prefix & (SHARD_COUNT - 1)].push((key, entry));
+        }
+
+        for (shard, entries) in self.shards.iter().zip(by_shard) {
+            if entries.is_empty() {
+                continue;
+            }
+            let mut guard = shard.write().await;
+            for (key, entry) in entries {
+                guard.put(key, entry);
+            }
+        }
+    }
+
+    /// Removes all entries.
+    pub async fn clear(&self) {
+        for shard in &self.shards {
+            shard.write().await.clear();
+        }
+    }
+}
 
 /// Initialize cache
 pub fn init_cache() -> TxVerificationCache {
-    lru::LruCache::new(CACHE_SIZE)
+    TxVerificationCache::default()
 }
 
 #[derive(Clone, Debug)]
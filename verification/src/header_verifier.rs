@@ -9,6 +9,7 @@ use ckb_traits::HeaderProvider;
 use ckb_types::core::{HeaderView, Version};
 use ckb_verification_traits::Verifier;
 use faketime::unix_time_as_millis;
+use rayon::prelude::*;
 
 /// Context-dependent verification checks for block header
 ///
@@ -26,14 +27,33 @@ impl<'a, DL: HeaderProvider> HeaderVerifier<'a, DL> {
             data_loader,
         }
     }
-}
 
-impl<'a, DL: HeaderProvider> Verifier for HeaderVerifier<'a, DL> {
-    type Target = HeaderView;
-    fn verify(&self, header: &Self::Target) -> Result<(), Error> {
+    /// Verifies the PoW of a batch of headers across the rayon pool.
+    ///
+    /// PoW evaluation is purely CPU bound and independent per header, so a
+    /// headers-sync message is hashed data-parallel here, after which each
+    /// header goes through [`verify_pow_checked`](Self::verify_pow_checked)
+    /// for the sequential contextual checks. Headers are handed to the
+    /// engine in chunks through `PowEngine::verify_many`, so an engine with
+    /// a vectorized kernel gets whole batches per call.
+    pub fn verify_pow_batch(&self, headers: &[HeaderView]) -> Result<(), Error> {
+        const POW_BATCH_CHUNK: usize = 8;
+        let pow = self.consensus.pow_engine();
+        headers.par_chunks(POW_BATCH_CHUNK).try_for_each(|chunk| {
+            let raw: Vec<_> = chunk.iter().map(|header| header.data()).collect();
+            if pow.verify_many(&raw).into_iter().all(|ok| ok) {
+                Ok(())
+            } else {
+                Err(PowError::InvalidNonce.into())
+            }
+        })
+    }
+
+    /// Equivalent to [`verify`](Verifier::verify) for a header whose PoW has
+    /// already been checked, e.g. through
+    /// [`verify_pow_batch`](Self::verify_pow_batch).
+    pub fn verify_pow_checked(&self, header: &HeaderView) -> Result<(), Error> {
         VersionVerifier::new(header, self.consensus.block_version()).verify()?;
-        // POW check first
-        PowVerifier::new(header, self.consensus.pow_engine().as_ref()).verify()?;
         let parent = self
             .data_loader
             .get_header(&header.parent_hash())
@@ -52,6 +72,15 @@ impl<'a, DL: HeaderProvider> Verifier for HeaderVerifier<'a, DL> {
     }
 }
 
+impl<'a, DL: HeaderProvider> Verifier for HeaderVerifier<'a, DL> {
+    type Target = HeaderView;
+    fn verify(&self, header: &Self::Target) -> Result<(), Error> {
+        // POW check first
+        PowVerifier::new(header, self.consensus.pow_engine().as_ref()).verify()?;
+        self.verify_pow_checked(header)
+    }
+}
+
 pub struct VersionVerifier<'a> {
     header: &'a HeaderView,
     block_version: Version,
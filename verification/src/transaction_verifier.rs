@@ -161,6 +161,22 @@ where
         Ok(Completed { cycles, fee })
     }
 
+    /// Perform context-dependent verification scheduling independent script
+    /// groups across a worker pool, return a `Result` to `CacheEntry`
+    pub fn verify_parallel(&self, max_cycles: Cycle) -> Result<Completed, Error>
+    where
+        DL: Sync,
+    {
+        let timer = Timer::start();
+        self.compatible.verify()?;
+        self.time_relative.verify()?;
+        self.capacity.verify()?;
+        let cycles = self.script.verify_parallel(max_cycles)?;
+        let fee = self.fee_calculator.transaction_fee()?;
+        metrics!(timing, "ckb.contextual_verified_tx", timer.stop());
+        Ok(Completed { cycles, fee })
+    }
+
     /// Perform complete a suspend context-dependent verification, return a `Result` to `CacheEntry`
     ///
     /// skip script verify will result in the return value cycle always is zero
@@ -332,6 +348,17 @@ impl<'a, DL: CellDataProvider + HeaderProvider> ScriptVerifier<'a, DL> {
         Ok(cycle)
     }
 
+    /// Perform script verification, running independent script groups in parallel
+    pub fn verify_parallel(&self, max_cycles: Cycle) -> Result<Cycle, Error>
+    where
+        DL: Sync,
+    {
+        let timer = Timer::start();
+        let cycle = self.inner.verify_parallel(max_cycles)?;
+        metrics!(timing, "ckb.verified_script", timer.stop());
+        Ok(cycle)
+    }
+
     /// Perform resumable script verification
     pub fn resumable_verify(&self, limit_cycles: Cycle) -> Result<VerifyResult, Error> {
         let timer = Timer::start();